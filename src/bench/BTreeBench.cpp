@@ -0,0 +1,139 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/BPlusTree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// One indexed column: B+tree vs std::multimap vs binary search over a sorted
+// (key, row) array. Lookups are lower_bound on keys drawn from the column;
+// range scans read the 100 entries following a lower_bound.
+template <typename K, typename KeyFn>
+static void bench_column(const FireRecords& recs, const std::string& column, KeyFn key, int maxThreads) {
+    const std::string bench = "btree";
+    const size_t n = recs.size();
+    const int lookups = 1000000;
+    const int scans = 100000;
+    const int span = 100;
+
+    std::vector<K> probes(lookups);
+    std::mt19937_64 rng(42);
+    for (auto& p : probes) p = key(recs[rng() % n]);
+
+    // ---- build: sort once, then each structure from the sorted pairs ----
+    auto t0 = clk::now();
+    std::vector<std::pair<K, uint32_t>> sorted(n);
+    for (size_t i = 0; i < n; ++i) sorted[i] = {key(recs[i]), (uint32_t)i};
+    std::sort(sorted.begin(), sorted.end());
+    double sortMs = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "sorted_array:" + column, 1, "build", (double)n, sortMs);
+
+    BPlusTree<K> tree;
+    t0 = clk::now();
+    tree.bulkLoad(sorted);
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "bplustree:" + column, 1, "build", (double)n, sortMs + ms);
+
+    std::multimap<K, uint32_t> map;
+    t0 = clk::now();
+    for (const auto& kv : sorted) map.emplace_hint(map.end(), kv.first, kv.second);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "std_multimap:" + column, 1, "build", (double)n, sortMs + ms);
+
+    const K top = std::numeric_limits<K>::max();
+    auto byKey = [](const std::pair<K, uint32_t>& a, K k) { return a.first < k; };
+
+    // Bounds outside the key range (±inf on floating columns) must land on
+    // the ends of the array, never on a node's padding.
+    std::vector<K> edges = {std::numeric_limits<K>::lowest(), top};
+    if (std::numeric_limits<K>::has_infinity) {
+        edges.push_back(-std::numeric_limits<K>::infinity());
+        edges.push_back(std::numeric_limits<K>::infinity());
+    }
+    std::vector<size_t> edgeBatch(edges.size());
+    tree.lowerBoundBatch(edges.data(), edges.size(), edgeBatch.data());
+    for (size_t e = 0; e < edges.size(); ++e) {
+        size_t expect = std::lower_bound(sorted.begin(), sorted.end(), edges[e], byKey) - sorted.begin();
+        size_t rows = 0, expectRows = 0;
+        tree.scan(edges[e], edges[e], [&](K, uint32_t) { ++rows; });
+        for (auto it = sorted.begin() + expect; it != sorted.end() && !(edges[e] < it->first); ++it) ++expectRows;
+        if (tree.lowerBound(edges[e]) != expect || edgeBatch[e] != expect || rows != expectRows) {
+            std::cerr << "Warning: btree/array differ on " << column << " at bound " << edges[e] << "\n";
+        }
+    }
+
+    for (int t : threadSweep(maxThreads)) {
+        // ---- point lookups (lower_bound) ----
+        size_t treeSum = 0, mapSum = 0, arraySum = 0;
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static) reduction(+:treeSum)
+        for (int q = 0; q < lookups; ++q) treeSum += tree.lowerBound(probes[q]);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow(bench, "bplustree:" + column, t, "lookup", (double)lookups, ms);
+
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static) reduction(+:mapSum)
+        for (int q = 0; q < lookups; ++q) mapSum += map.lower_bound(probes[q])->second;
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow(bench, "std_multimap:" + column, t, "lookup", (double)lookups, ms);
+
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static) reduction(+:arraySum)
+        for (int q = 0; q < lookups; ++q) {
+            arraySum += std::lower_bound(sorted.begin(), sorted.end(), probes[q], byKey) - sorted.begin();
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow(bench, "sorted_array:" + column, t, "lookup", (double)lookups, ms);
+        if (treeSum != arraySum) std::cerr << "Warning: btree/array lookups differ on " << column << "\n";
+
+        // ---- range scans: 100 entries from a lower_bound ----
+        size_t treeRows = 0, mapRows = 0, arrayRows = 0;
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static) reduction(+:treeRows)
+        for (int q = 0; q < scans; ++q) {
+            int left = span;
+            tree.scan(probes[q], top, [&](K, uint32_t) { ++treeRows; return --left > 0; });
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow(bench, "bplustree:" + column, t, "range_scan", (double)scans, ms);
+
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static) reduction(+:mapRows)
+        for (int q = 0; q < scans; ++q) {
+            auto it = map.lower_bound(probes[q]);
+            for (int i = 0; i < span && it != map.end(); ++i, ++it) ++mapRows;
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow(bench, "std_multimap:" + column, t, "range_scan", (double)scans, ms);
+
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static) reduction(+:arrayRows)
+        for (int q = 0; q < scans; ++q) {
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), probes[q], byKey);
+            for (int i = 0; i < span && it != sorted.end(); ++i, ++it) ++arrayRows;
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow(bench, "sorted_array:" + column, t, "range_scan", (double)scans, ms);
+        if (treeRows != mapRows || treeRows != arrayRows) {
+            std::cerr << "Warning: btree/map/array range results differ on " << column << "\n";
+        }
+    }
+}
+
+void bPlusTree(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    bench_column<double>(recs, "value", [](const FireRecord& r) { return r.numericValue; }, maxThreads);
+    bench_column<int32_t>(recs, "utc_minutes", [](const FireRecord& r) { return (int32_t)r.utc_minutes; }, maxThreads);
+    bench_column<int32_t>(recs, "aqi", [](const FireRecord& r) { return (int32_t)r.aqi; }, maxThreads);
+}
+
+} // namespace Benchmarks
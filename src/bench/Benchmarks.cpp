@@ -0,0 +1,86 @@
+#include "bench/Benchmarks.h"
+
+#include <functional>
+#include <iostream>
+#include <map>
+
+namespace Benchmarks {
+
+using BenchFn = std::function<void(const VectorDataSource&, int)>;
+using MapBenchFn = std::function<void(const MapDataSource&, int)>;
+
+static const std::map<std::string, BenchFn>& table() {
+    static const std::map<std::string, BenchFn> benches = {
+        {"bitsliced", bitSliced},
+        {"bloom", bloom},
+        {"btree", bPlusTree},
+        {"cluster", cluster},
+        {"cracking", cracking},
+        {"dictionary", dictionary},
+        {"encode", encode},
+        {"eytzinger", eytzinger},
+        {"geofence", geofence},
+        {"heatmap", heatmap},
+        {"idw", idw},
+        {"interleave", interleave},
+        {"knn", knn},
+        {"near", near},
+        {"point", point},
+        {"skiplist", skipList},
+        {"sort", radixSort},
+    };
+    return benches;
+}
+
+static const std::map<std::string, MapBenchFn>& mapTable() {
+    static const std::map<std::string, MapBenchFn> benches = {
+        {"skiplist", skipListMap},
+    };
+    return benches;
+}
+
+bool run(const std::string& name, const VectorDataSource& data, int maxThreads) {
+    auto it = table().find(name);
+    if (it == table().end()) return false;
+    printHeader();
+    it->second(data, maxThreads);
+    return true;
+}
+
+bool run(const std::string& name, const MapDataSource& data, int maxThreads) {
+    auto it = mapTable().find(name);
+    if (it == mapTable().end()) return false;
+    printHeader();
+    it->second(data, maxThreads);
+    return true;
+}
+
+std::vector<std::string> names(const std::string& impl) {
+    std::vector<std::string> out;
+    if (impl == "map") {
+        for (const auto& [name, fn] : mapTable()) out.push_back(name);
+    } else {
+        for (const auto& [name, fn] : table()) out.push_back(name);
+    }
+    return out;
+}
+
+std::vector<int> threadSweep(int maxThreads) {
+    std::vector<int> out;
+    for (int t = 1; t < maxThreads; t *= 2) out.push_back(t);
+    out.push_back(maxThreads < 1 ? 1 : maxThreads);
+    return out;
+}
+
+void printHeader() {
+    std::cout << "bench,structure,threads,operation,ops,ms,mops_per_s\n";
+}
+
+void printRow(const std::string& bench, const std::string& structure, int threads,
+              const std::string& operation, double ops, double ms) {
+    double mops = ms > 0 ? ops / (ms * 1000.0) : 0.0;
+    std::cout << bench << "," << structure << "," << threads << "," << operation << ","
+              << ops << "," << ms << "," << mops << "\n";
+}
+
+} // namespace Benchmarks
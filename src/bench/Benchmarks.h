@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <vector>
+
+class MapDataSource;
+class VectorDataSource;
+
+// Micro-benchmarks selected with --bench NAME. Each prints CSV rows
+// (bench,structure,threads,operation,ops,ms,mops_per_s) to stdout.
+namespace Benchmarks {
+    // Returns false for an unknown benchmark name. The map source runs the
+    // benchmarks of the structures it uses (skiplist).
+    bool run(const std::string& name, const VectorDataSource& data, int maxThreads);
+    bool run(const std::string& name, const MapDataSource& data, int maxThreads);
+
+    // Names accepted by run() for impl ("vector" or "map"), for usage text.
+    std::vector<std::string> names(const std::string& impl = "vector");
+
+    // 1, 2, 4, ... up to maxThreads (always includes maxThreads).
+    std::vector<int> threadSweep(int maxThreads);
+
+    void printHeader();
+    void printRow(const std::string& bench, const std::string& structure, int threads,
+                  const std::string& operation, double ops, double ms);
+
+    // Individual benchmarks
+    void bitSliced(const VectorDataSource& data, int maxThreads);
+    void bloom(const VectorDataSource& data, int maxThreads);
+    void bPlusTree(const VectorDataSource& data, int maxThreads);
+    void cluster(const VectorDataSource& data, int maxThreads);
+    void cracking(const VectorDataSource& data, int maxThreads);
+    void dictionary(const VectorDataSource& data, int maxThreads);
+    void encode(const VectorDataSource& data, int maxThreads);
+    void eytzinger(const VectorDataSource& data, int maxThreads);   // single-threaded latency
+    void geofence(const VectorDataSource& data, int maxThreads);
+    void heatmap(const VectorDataSource& data, int maxThreads);
+    void idw(const VectorDataSource& data, int maxThreads);
+    void interleave(const VectorDataSource& data, int maxThreads);   // single-threaded latency
+    void knn(const VectorDataSource& data, int maxThreads);
+    void near(const VectorDataSource& data, int maxThreads);
+    void radixSort(const VectorDataSource& data, int maxThreads);
+    void point(const VectorDataSource& data, int maxThreads);
+    void skipList(const VectorDataSource& data, int maxThreads);     // sweeps to at least 64 threads
+    void skipListMap(const MapDataSource& data, int maxThreads);
+}
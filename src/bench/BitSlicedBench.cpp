@@ -0,0 +1,127 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/BitSlicedIndex.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+template <typename KeyFn>
+static void bench_column(const FireRecords& recs, const std::string& column, KeyFn key, int maxThreads) {
+    const std::string bench = "bitsliced";
+    const size_t n = recs.size();
+    const size_t words = (n + BitSlicedIndex::kBlockRows - 1) / BitSlicedIndex::kBlockRows * BitSlicedIndex::kBlockWords;
+    const int repeats = 20;
+
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i) values[i] = key(recs[i]);
+
+    auto start = clk::now();
+    BitSlicedIndex bsi;
+    bsi.build(values);
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "bsi:" + column, maxThreads, "build", (double)n, ms);
+    std::cerr << "bitsliced " << column << ": " << bsi.distinct() << " distinct values, " << bsi.bits()
+              << " slices, " << bsi.memoryBytes() << " bytes\n";
+
+    // Sorted (key, row) index, NaN left out like the bit-sliced index does
+    start = clk::now();
+    std::vector<std::pair<double, uint32_t>> sorted;
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i) if (!std::isnan(values[i])) sorted.emplace_back(values[i], (uint32_t)i);
+    parallel_radix_sort(sorted);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "sorted:" + column, maxThreads, "build", (double)n, ms);
+
+    size_t mismatches = 0;
+    // Ranges [0, q] over the value distribution: 0.1% .. 50% selectivity
+    for (double selectivity : {0.001, 0.01, 0.1, 0.5}) {
+        if (sorted.empty()) break;
+        const double lo = sorted.front().first;
+        const double hi = sorted[std::min(sorted.size() - 1, (size_t)(selectivity * (double)sorted.size()))].first;
+        const std::string op = "select_" + std::to_string(selectivity).substr(0, 5);
+
+        // Row-store scan: the predicate over each FireRecord
+        std::vector<uint64_t> expect(words, 0);
+        start = clk::now();
+        for (int r = 0; r < repeats; ++r) {
+            std::fill(expect.begin(), expect.end(), 0);
+            for (size_t i = 0; i < n; ++i) {
+                const double v = key(recs[i]);
+                if (v >= lo && v <= hi) expect[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, "row_scan:" + column, 1, op, (double)repeats, ms);
+
+        // Sorted index: binary search, then set a bit per row
+        std::vector<uint64_t> got(words);
+        start = clk::now();
+        for (int r = 0; r < repeats; ++r) {
+            std::fill(got.begin(), got.end(), 0);
+            auto first = std::lower_bound(sorted.begin(), sorted.end(), lo,
+                [](const std::pair<double, uint32_t>& e, double v) { return e.first < v; });
+            for (; first != sorted.end() && first->first <= hi; ++first) got[first->second / 64] |= uint64_t(1) << (first->second % 64);
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, "sorted:" + column, 1, op, (double)repeats, ms);
+        mismatches += got != expect;
+
+        for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+            const int saved = omp_get_max_threads();
+            omp_set_num_threads(t);
+#endif
+            // Column scan: contiguous doubles, 64 compares per output word
+            start = clk::now();
+            for (int r = 0; r < repeats; ++r) {
+                #pragma omp parallel for schedule(static)
+                for (long long w = 0; w < (long long)words; ++w) {
+                    const size_t base = (size_t)w * 64, count = base < n ? std::min<size_t>(64, n - base) : 0;
+                    uint64_t bits = 0;
+                    #pragma omp simd reduction(|:bits)
+                    for (size_t j = 0; j < count; ++j) {
+                        const double v = values[base + j];
+                        bits |= (uint64_t)(v >= lo && v <= hi) << j;
+                    }
+                    got[w] = bits;
+                }
+            }
+            ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+            printRow(bench, "simd_scan:" + column, t, op, (double)repeats, ms);
+            mismatches += got != expect;
+
+            start = clk::now();
+            for (int r = 0; r < repeats; ++r) got = bsi.select(lo, hi);
+            ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+            omp_set_num_threads(saved);
+#endif
+            printRow(bench, "bsi:" + column, t, op, (double)repeats, ms);
+            mismatches += got != expect;
+        }
+    }
+    if (mismatches) std::cerr << "Warning: bitsliced " << column << ": " << mismatches << " bitmaps disagree with a scan\n";
+}
+
+// Range predicates producing a row bitmap, at 0.1% to 50% selectivity:
+// bit-sliced index vs a row-store scan, a SIMD column scan and a sorted
+// (key, row) index, on value and raw_value.
+void bitSliced(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    bench_column(recs, "value", [](const FireRecord& r) { return r.numericValue; }, maxThreads);
+    bench_column(recs, "raw_value", [](const FireRecord& r) { return (double)r.raw_value; }, maxThreads);
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,120 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/SegmentBloom.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Per-hour Bloom filters on site, AQS and agency ids: build at 1..N threads,
+// false-positive rate over every absent id, segments skipped for point
+// queries (vs the ideal), and pruned vs full scans of 200 point queries.
+void bloom(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    const SiteTable& sites = data.sites();
+    if (recs.empty()) return;
+    const std::string bench = "bloom";
+
+    SegmentBloom filters;
+    for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        auto start = clk::now();
+        filters.build(recs, sites);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, "segment_bloom", t, "build", (double)recs.size(), ms);
+    }
+    std::cerr << "bloom: " << filters.segments() << " hourly segments in " << filters.runs() << " runs, "
+              << filters.memoryBytes() << " bytes\n";
+
+    const Dictionaries& dicts = data.dictionaries();
+    struct Column { const char* name; SegmentBloom::Key key; size_t ids; uint32_t SiteRecord::*field; };
+    const Column columns[] = {
+        {"site_id", SegmentBloom::Key::Site, dicts.frozen.site.size(), &SiteRecord::name_id},
+        {"aqs_id", SegmentBloom::Key::Aqs, dicts.frozen.aqs.size(), &SiteRecord::aqs_id},
+        {"agency_id", SegmentBloom::Key::Agency, dicts.frozen.agency.size(), &SiteRecord::agency_id},
+    };
+    const size_t segments = filters.segments();
+    std::vector<int32_t> hours(segments);
+    for (size_t s = 0; s < segments; ++s) hours[s] = filters.segmentHour(s);
+    auto segment_of = [&](const FireRecord& r) {
+        const int32_t h = r.utc_minutes >= 0 ? r.utc_minutes / 60 : -((-r.utc_minutes + 59) / 60);
+        return (size_t)(std::lower_bound(hours.begin(), hours.end(), h) - hours.begin());
+    };
+
+    std::mt19937_64 rng(11);
+    for (const Column& c : columns) {
+        // Exact (segment, id) membership and per-id row counts
+        std::vector<std::vector<char>> present(segments, std::vector<char>(c.ids, 0));
+        std::vector<size_t> rowsPerId(c.ids, 0);
+        for (const auto& r : recs) {
+            const uint32_t id = sites[r.site_id].*c.field;
+            present[segment_of(r)][id] = 1;
+            ++rowsPerId[id];
+        }
+
+        // False positives over every absent (segment, id); skips per point query
+        size_t negatives = 0, falsePositives = 0, skipped = 0, ideal = 0;
+        for (size_t s = 0; s < segments; ++s) {
+            for (size_t id = 0; id < c.ids; ++id) {
+                const bool maybe = filters.mayContain(c.key, s, (long long)id, (long long)id);
+                if (!present[s][id]) {
+                    ++negatives;
+                    ++ideal;
+                    falsePositives += maybe ? 1 : 0;
+                }
+                skipped += maybe ? 0 : 1;
+                if (present[s][id] && !maybe) std::cerr << "Warning: bloom " << c.name << " lost id " << id << "\n";
+            }
+        }
+        std::cerr << std::fixed << std::setprecision(2) << "bloom " << c.name << ": false positives "
+                  << 100.0 * (double)falsePositives / (double)std::max<size_t>(1, negatives) << "%, segments skipped per point query "
+                  << (double)skipped / (double)std::max<size_t>(1, c.ids) << " of " << segments << " (ideal "
+                  << (double)ideal / (double)std::max<size_t>(1, c.ids) << ")\n" << std::defaultfloat;
+
+        // Point queries: full scan vs scanning only the runs the filters keep
+        std::vector<uint32_t> queries(200);
+        for (auto& q : queries) q = (uint32_t)(rng() % std::max<size_t>(1, c.ids));
+        std::vector<size_t> expect(queries.size());
+        auto start = clk::now();
+        for (size_t q = 0; q < queries.size(); ++q) {
+            size_t hits = 0;
+            for (const auto& r : recs) hits += (sites[r.site_id].*c.field == queries[q]) ? 1 : 0;
+            expect[q] = hits;
+        }
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, std::string("full_scan:") + c.name, 1, "point_query", (double)queries.size(), ms);
+
+        size_t mismatches = 0, segmentsSkipped = 0;
+        start = clk::now();
+        for (size_t q = 0; q < queries.size(); ++q) {
+            size_t hits = 0;
+            segmentsSkipped += filters.forEachRun(c.key, queries[q], queries[q], [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) hits += (sites[recs[i].site_id].*c.field == queries[q]) ? 1 : 0;
+            });
+            mismatches += hits != expect[q] || hits != rowsPerId[queries[q]];
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, std::string("bloom_scan:") + c.name, 1, "point_query", (double)queries.size(), ms);
+        std::cerr << "bloom " << c.name << ": " << segmentsSkipped << " of " << queries.size() * segments
+                  << " segments skipped over " << queries.size() << " point queries\n";
+        if (mismatches) std::cerr << "Warning: bloom " << c.name << ": " << mismatches << " queries disagree with a scan\n";
+    }
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,113 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/ZoneMap.h"
+#include "utility/Clustering.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Physical orders compared: load order, (parameter, site, time) and Z-order
+// of (lat, lon, hour). Per order: the clustering sort at 1..N threads, zone
+// map pruning for typical predicates, pruned scans, and compression estimate.
+void cluster(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& loaded = data.fireRecords();
+    const SiteTable& sites = data.sites();
+    if (loaded.empty()) return;
+
+    // Predicates: busiest day, PM2.5, unhealthy AQI, a latitude band, the Bay Area
+    std::unordered_map<int32_t, size_t> dayCounts;
+    for (const auto& r : loaded) ++dayCounts[r.utc_minutes / 1440];
+    const int32_t day = std::max_element(dayCounts.begin(), dayCounts.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+    const uint32_t pm = data.dictionaries().frozen.parameter.find("PM2.5");
+    struct Predicate { const char* name; ZoneMap::Field field; double lo, hi; };
+    const Predicate predicates[] = {
+        {"utc_day", ZoneMap::Field::UTCMinutes, day * 1440.0, day * 1440.0 + 1439.0},
+        {"parameter", ZoneMap::Field::ParameterId, (double)pm, (double)pm},
+        {"aqi_unhealthy", ZoneMap::Field::AQI, 151.0, 1e9},
+        {"latitude_band", ZoneMap::Field::Latitude, 37.0, 38.0},
+        {"bay_area_lon", ZoneMap::Field::Longitude, -123.0, -121.5},
+    };
+    auto field_value = [&](const FireRecord& r, ZoneMap::Field f) -> double {
+        switch (f) {
+            case ZoneMap::Field::UTCMinutes: return r.utc_minutes;
+            case ZoneMap::Field::ParameterId: return r.parameter_id;
+            case ZoneMap::Field::AQI: return r.aqi;
+            case ZoneMap::Field::Latitude: return sites[r.site_id].latitude;
+            case ZoneMap::Field::Longitude: return sites[r.site_id].longitude;
+            default: return r.numericValue;
+        }
+    };
+
+    const Clustering::Key keys[] = {Clustering::Key::None, Clustering::Key::ParameterSiteTime, Clustering::Key::ZOrder};
+    std::vector<size_t> expected;
+    for (Clustering::Key key : keys) {
+        const std::string order = key == Clustering::Key::None ? "load" : Clustering::name(key);
+        FireRecords recs = loaded;
+
+        if (key != Clustering::Key::None) {
+            std::vector<uint32_t> perm;
+            for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+                const int saved = omp_get_max_threads();
+                omp_set_num_threads(t);
+#endif
+                auto start = clk::now();
+                perm = Clustering::order(loaded, sites, key);
+                double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+                printRow("cluster", order, t, "sort_keys", (double)loaded.size(), ms);
+
+                FireRecords copy = loaded;
+                start = clk::now();
+                Clustering::permute(copy, perm);
+                ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+                omp_set_num_threads(saved);
+#endif
+                printRow("cluster", order, t, "permute_rows", (double)loaded.size(), ms);
+            }
+            Clustering::permute(recs, perm);
+        }
+
+        ZoneMap zones;
+        zones.build(recs, sites);
+        std::ostringstream pruning;
+        pruning << std::fixed << std::setprecision(1);
+        for (size_t p = 0; p < sizeof(predicates) / sizeof(predicates[0]); ++p) {
+            const Predicate& pred = predicates[p];
+            pruning << " " << pred.name << "=" << 100.0 * zones.prunedFraction(pred.field, pred.lo, pred.hi) << "%";
+
+            size_t hits = 0;
+            auto start = clk::now();
+            for (size_t b = 0; b < zones.blocks(); ++b) {
+                if (!zones.mayContain(pred.field, b, pred.lo, pred.hi)) continue;
+                for (size_t i = zones.blockBegin(b); i < zones.blockEnd(b); ++i) {
+                    const double v = field_value(recs[i], pred.field);
+                    hits += (v >= pred.lo && v <= pred.hi) ? 1 : 0;
+                }
+            }
+            double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+            printRow("cluster", order, 1, std::string("zone_scan_") + pred.name, (double)recs.size(), ms);
+
+            if (key == Clustering::Key::None) expected.push_back(hits);
+            else if (hits != expected[p]) std::cerr << "Warning: cluster " << order << ": " << pred.name << " matched " << hits << " rows, load order " << expected[p] << "\n";
+        }
+        std::cerr << "cluster " << order << ": blocks pruned" << pruning.str()
+                  << "; estimated compression " << Clustering::compressionRatio(recs, ZoneMap::kBlockRows) << "x\n";
+    }
+}
+
+} // namespace Benchmarks
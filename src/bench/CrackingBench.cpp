@@ -0,0 +1,116 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/BPlusTree.h"
+#include "index/CrackerIndex.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+template <typename K, typename KeyFn>
+static void bench_column(const FireRecords& recs, const std::string& column, KeyFn key, int maxThreads) {
+    const std::string bench = "cracking";
+    const size_t n = recs.size();
+    auto pairs = [&] {
+        std::vector<std::pair<K, uint32_t>> out(n);
+        for (size_t i = 0; i < n; ++i) out[i] = {key(recs[i]), (uint32_t)i};
+        return out;
+    };
+
+    // ~1% ranges between keys at random ranks
+    std::vector<K> sorted(n);
+    for (size_t i = 0; i < n; ++i) sorted[i] = key(recs[i]);
+    std::sort(sorted.begin(), sorted.end());
+    const size_t queries = 1000, span = std::max<size_t>(1, n / 100);
+    std::mt19937_64 rng(7);
+    std::vector<std::pair<K, K>> ranges(queries);
+    for (auto& r : ranges) {
+        const size_t at = rng() % n;
+        r = {sorted[at], sorted[std::min(n - 1, at + span)]};
+    }
+
+    // Full scans, also the expected counts
+    std::vector<size_t> expect(queries);
+    auto start = clk::now();
+    for (size_t q = 0; q < queries; ++q) {
+        size_t hits = 0;
+        for (const auto& r : recs) { const K k = key(r); hits += (k >= ranges[q].first && k <= ranges[q].second) ? 1 : 0; }
+        expect[q] = hits;
+    }
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "scan:" + column, 1, "range_query", (double)queries, ms);
+
+    // Cracking from cold: first query, then successive decades
+    CrackerIndex<K> cracker;
+    size_t mismatches = 0, q = 0;
+    for (size_t stop : {(size_t)1, (size_t)10, (size_t)100, queries}) {
+        const size_t first = q;
+        start = clk::now();
+        for (; q < stop; ++q) mismatches += cracker.rows(ranges[q].first, ranges[q].second, pairs).size() != expect[q];
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, "cracker:" + column, 1, "range_query_" + std::to_string(first + 1) + "_" + std::to_string(stop),
+                 (double)(stop - first), ms);
+    }
+    std::cerr << "cracking " << column << ": " << cracker.pieces() << " pieces after " << queries << " queries\n";
+
+    // B+tree: full build, then the same queries
+    start = clk::now();
+    auto keyed = pairs();
+    parallel_radix_sort(keyed);
+    BPlusTree<K> tree;
+    tree.bulkLoad(keyed);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "btree:" + column, 1, "build", (double)n, ms);
+    start = clk::now();
+    for (size_t i = 0; i < queries; ++i) {
+        size_t hits = 0;
+        tree.scan(ranges[i].first, ranges[i].second, [&](K, uint32_t) { ++hits; });
+        mismatches += hits != expect[i];
+    }
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "btree:" + column, 1, "range_query", (double)queries, ms);
+
+    // Concurrent queries on a cold cracker
+    for (int t : threadSweep(maxThreads)) {
+        auto shared = std::make_unique<CrackerIndex<K>>();
+        size_t wrong = 0;
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        start = clk::now();
+        #pragma omp parallel for schedule(dynamic, 8) reduction(+:wrong)
+        for (long long i = 0; i < (long long)queries; ++i) {
+            wrong += shared->rows(ranges[i].first, ranges[i].second, pairs).size() != expect[i];
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, "cracker_concurrent:" + column, t, "range_query", (double)queries, ms);
+        mismatches += wrong;
+    }
+    if (mismatches) std::cerr << "Warning: cracking " << column << ": " << mismatches << " queries disagree with a scan\n";
+}
+
+// Cracking vs scanning vs an upfront B+tree over 1000 random ~1% ranges:
+// convergence from a cold column, and concurrent queries at 1..N threads.
+void cracking(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    bench_column<double>(recs, "value", [](const FireRecord& r) { return r.numericValue; }, maxThreads);
+    bench_column<int32_t>(recs, "utc", [](const FireRecord& r) { return r.utc_minutes; }, maxThreads);
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,113 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Heap estimate of a node-based map: buckets, nodes, and key storage past SSO.
+static size_t map_bytes(const std::unordered_map<std::string, uint32_t>& m) {
+    size_t bytes = m.bucket_count() * sizeof(void*);
+    for (const auto& kv : m) {
+        bytes += sizeof(kv) + 2 * sizeof(void*);
+        if (kv.first.capacity() > 15) bytes += kv.first.capacity() + 1;
+    }
+    return bytes;
+}
+
+static void bench_dictionary(const std::string& name, const FrozenDictionary& frozen,
+                             const std::vector<uint32_t>& rowIds, int maxThreads) {
+    const std::string bench = "dictionary";
+    if (frozen.size() == 0 || rowIds.empty()) return;
+
+    // The map the loader used to keep, rebuilt from the frozen names
+    auto t0 = clk::now();
+    std::unordered_map<std::string, uint32_t> map;
+    for (uint32_t id = 0; id < frozen.size(); ++id) map.emplace(std::string(frozen.name(id)), id);
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "unordered_map:" + name, 1, "build", (double)frozen.size(), ms);
+
+    std::vector<std::string> names(frozen.size());
+    for (uint32_t id = 0; id < frozen.size(); ++id) names[id] = std::string(frozen.name(id));
+    t0 = clk::now();
+    const FrozenDictionary rebuilt(names);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "frozen:" + name, 1, "build", (double)frozen.size(), ms);
+
+    // Hits follow the row distribution; misses are names with a byte appended
+    const size_t probes = 1 << 20;
+    std::mt19937_64 rng(42);
+    std::vector<std::string> hits(probes), misses(probes);
+    std::vector<uint32_t> ids(probes);
+    for (size_t i = 0; i < probes; ++i) {
+        ids[i] = rowIds[rng() % rowIds.size()];
+        hits[i] = names[ids[i]];
+        misses[i] = hits[i] + '~';
+    }
+
+    auto timed = [&](int threads, const std::string& structure, const std::string& op, auto body) {
+        size_t sink = 0;
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#endif
+        auto start = clk::now();
+        #pragma omp parallel for schedule(static) reduction(+:sink)
+        for (long long i = 0; i < (long long)probes; ++i) sink += body((size_t)i);
+        double elapsed = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, structure + ":" + name, threads, op, (double)probes, elapsed);
+        return sink;
+    };
+
+    for (int t : threadSweep(maxThreads)) {
+        size_t mapHits = timed(t, "unordered_map", "find_hit", [&](size_t i) {
+            auto it = map.find(hits[i]);
+            return it == map.end() ? (size_t)0 : (size_t)it->second + 1;
+        });
+        size_t frozenHits = timed(t, "frozen", "find_hit", [&](size_t i) {
+            const uint32_t id = frozen.find(hits[i]);
+            return id == FrozenDictionary::kNotFound ? (size_t)0 : (size_t)id + 1;
+        });
+        timed(t, "unordered_map", "find_miss", [&](size_t i) { return map.count(misses[i]); });
+        timed(t, "frozen", "find_miss", [&](size_t i) { return (size_t)(frozen.find(misses[i]) != FrozenDictionary::kNotFound); });
+        timed(t, "vector_string", "id_to_name", [&](size_t i) { return names[ids[i]].size(); });
+        timed(t, "frozen", "id_to_name", [&](size_t i) { return frozen.name(ids[i]).size(); });
+        if (mapHits != frozenHits) std::cerr << "Warning: dictionary " << name << ": frozen and map lookups disagree\n";
+    }
+
+    size_t vectorBytes = names.capacity() * sizeof(std::string);
+    for (const auto& s : names) if (s.capacity() > 15) vectorBytes += s.capacity() + 1;
+    std::cerr << "dictionary " << name << ": " << frozen.size() << " names, map + name vector "
+              << map_bytes(map) + vectorBytes << " bytes, frozen " << frozen.memoryBytes() << " bytes\n";
+}
+
+// Frozen perfect-hash dictionaries vs the load-time unordered_map + name
+// vector, for the site-name and AQS-id dictionaries, probed by row frequency.
+void dictionary(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    const Dictionaries& dicts = data.dictionaries();
+
+    std::vector<uint32_t> siteIds(recs.size()), aqsIds(recs.size());
+    for (size_t i = 0; i < recs.size(); ++i) {
+        siteIds[i] = dicts.sites[recs[i].site_id].name_id;
+        aqsIds[i] = dicts.sites[recs[i].site_id].aqs_id;
+    }
+    bench_dictionary("site", dicts.frozen.site, siteIds, maxThreads);
+    bench_dictionary("aqs", dicts.frozen.aqs, aqsIds, maxThreads);
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,139 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "utility/BatchEncoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+namespace {
+
+// The string columns of a fire load, rebuilt from the loaded rows
+struct RawRows {
+    std::vector<std::string> column[5];   // parameter, unit, site, agency, aqs
+    std::vector<float> latitude, longitude;
+    std::vector<size_t> taskBegin;        // one load task per UTC hour run, + end
+};
+
+// Ids one task's dictionaries assign: per column, then the site row
+using TaskIds = std::vector<std::vector<uint32_t>>;
+
+// The loader's previous path: five map get-or-adds and a site get-or-add per row
+TaskIds encode_rows(const RawRows& raw, size_t begin, size_t end) {
+    Dictionaries d;
+    std::unordered_map<std::string, uint32_t>* maps[5] = {&d.parameter_dict, &d.unit_dict, &d.site_dict, &d.agency_dict, &d.aqs_dict};
+    std::vector<std::string>* names[5] = {&d.parameter_names, &d.unit_names, &d.site_names, &d.agency_names, &d.aqs_names};
+    TaskIds ids(6, std::vector<uint32_t>(end - begin));
+    for (size_t i = begin; i < end; ++i) {
+        for (size_t c = 0; c < 5; ++c) ids[c][i - begin] = dict_get_or_add_named(*maps[c], *names[c], raw.column[c][i]);
+        SiteRecord site;
+        site.latitude = raw.latitude[i];
+        site.longitude = raw.longitude[i];
+        site.name_id = ids[2][i - begin];
+        site.agency_id = ids[3][i - begin];
+        site.aqs_id = ids[4][i - begin];
+        ids[5][i - begin] = site_get_or_add(d, site);
+    }
+    return ids;
+}
+
+// The loader's batched path: each column encoded a batch at a time
+TaskIds encode_batched(const RawRows& raw, size_t begin, size_t end) {
+    constexpr size_t kBatch = BatchEncoder<std::string>::kBatch;
+    Dictionaries d;
+    BatchEncoder<std::string> encoders[5] = {
+        {d.parameter_names}, {d.unit_names}, {d.site_names}, {d.agency_names}, {d.aqs_names}};
+    BatchEncoder<SiteRecord, SiteRecordHash> siteRows(d.sites);
+    TaskIds ids(6, std::vector<uint32_t>(end - begin));
+    const std::string* keys[kBatch];
+    SiteRecord sites[kBatch];
+    const SiteRecord* siteKeys[kBatch];
+    for (size_t b = begin; b < end; b += kBatch) {
+        const size_t m = std::min(kBatch, end - b);
+        for (size_t c = 0; c < 5; ++c) {
+            for (size_t k = 0; k < m; ++k) keys[k] = &raw.column[c][b + k];
+            encoders[c].encode(keys, m, ids[c].data() + (b - begin));
+        }
+        for (size_t k = 0; k < m; ++k) {
+            sites[k].latitude = raw.latitude[b + k];
+            sites[k].longitude = raw.longitude[b + k];
+            sites[k].name_id = ids[2][b - begin + k];
+            sites[k].agency_id = ids[3][b - begin + k];
+            sites[k].aqs_id = ids[4][b - begin + k];
+            siteKeys[k] = &sites[k];
+        }
+        siteRows.encode(siteKeys, m, ids[5].data() + (b - begin));
+    }
+    return ids;
+}
+
+} // namespace
+
+// Dictionary encoding as the fire loader runs it, per load task (one per
+// UTC hour of rows, each with its own dictionaries): row-at-a-time map
+// get-or-adds vs batched hash / prefetch / probe, at 1..N threads. Rows
+// per second are ops / ms * 1000; ids must agree.
+void encode(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    const std::string bench = "encode";
+    const Dictionaries& dicts = data.dictionaries();
+    const SiteTable& sites = data.sites();
+
+    RawRows raw;
+    for (auto& c : raw.column) c.resize(recs.size());
+    raw.latitude.resize(recs.size());
+    raw.longitude.resize(recs.size());
+    for (size_t i = 0; i < recs.size(); ++i) {
+        const FireRecord& r = recs[i];
+        const SiteRecord& s = sites[r.site_id];
+        raw.column[0][i] = std::string(dicts.frozen.parameter.name(r.parameter_id));
+        raw.column[1][i] = std::string(dicts.frozen.unit.name(r.unit_id));
+        raw.column[2][i] = std::string(dicts.frozen.site.name(s.name_id));
+        raw.column[3][i] = std::string(dicts.frozen.agency.name(s.agency_id));
+        raw.column[4][i] = std::string(dicts.frozen.aqs.name(s.aqs_id));
+        raw.latitude[i] = s.latitude;
+        raw.longitude[i] = s.longitude;
+        if (i == 0 || recs[i].utc_minutes / 60 != recs[i - 1].utc_minutes / 60) raw.taskBegin.push_back(i);
+    }
+    raw.taskBegin.push_back(recs.size());
+    const long long tasks = (long long)raw.taskBegin.size() - 1;
+    std::cerr << "encode: " << recs.size() << " rows in " << tasks << " tasks\n";
+
+    std::vector<TaskIds> expect(tasks), got(tasks);
+    size_t mismatches = 0;
+    for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        auto start = clk::now();
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long k = 0; k < tasks; ++k) expect[k] = encode_rows(raw, raw.taskBegin[k], raw.taskBegin[k + 1]);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, "row_at_a_time", t, "encode_rows", (double)recs.size(), ms);
+
+        start = clk::now();
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long k = 0; k < tasks; ++k) got[k] = encode_batched(raw, raw.taskBegin[k], raw.taskBegin[k + 1]);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, "batched_prefetch", t, "encode_rows", (double)recs.size(), ms);
+        mismatches += got != expect;
+    }
+    if (mismatches) std::cerr << "Warning: encode: batched ids differ from row-at-a-time ids\n";
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,111 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/EytzingerIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Probe latency rather than throughput: each probe's key depends on the
+// previous answer, so the CPU cannot overlap consecutive searches.
+template <typename K, typename Search>
+static double chase_ms(const std::vector<K>& probes, int count, Search search, size_t& sink) {
+    size_t idx = 0, pos = 0;
+    auto t0 = clk::now();
+    for (int q = 0; q < count; ++q) {
+        pos = search(probes[idx]);
+        sink += pos;
+        idx = (idx + 1 + (pos & 1)) % probes.size();
+    }
+    return std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+}
+
+// Stream a buffer larger than the last-level cache so the next probes start cold.
+static void evict_caches(std::vector<char>& scratch) {
+    for (size_t i = 0; i < scratch.size(); i += 64) scratch[i] = (char)(scratch[i] + 1);
+}
+
+template <typename K, typename KeyFn>
+static void bench_column(const FireRecords& recs, const std::string& column, KeyFn key) {
+    const std::string bench = "eytzinger";
+    const size_t n = recs.size();
+
+    std::vector<std::pair<K, uint32_t>> pairs(n);
+    for (size_t i = 0; i < n; ++i) pairs[i] = {key(recs[i]), (uint32_t)i};
+    std::sort(pairs.begin(), pairs.end());
+    std::vector<K> sorted(n);
+    for (size_t i = 0; i < n; ++i) sorted[i] = pairs[i].first;
+
+    EytzingerIndex<K> eytz;
+    auto t0 = clk::now();
+    eytz.bulkLoad(pairs);
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "eytzinger:" + column, 1, "build", (double)n, ms);
+
+    auto eytzSearch = [&](K k) { return eytz.lowerBound(k); };
+    auto stdSearch = [&](K k) { return (size_t)(std::lower_bound(sorted.begin(), sorted.end(), k) - sorted.begin()); };
+
+    std::mt19937_64 rng(42);
+    std::vector<K> coldProbes(1 << 16);
+    for (auto& p : coldProbes) p = key(recs[rng() % n]);
+    std::vector<K> warmProbes(1024);
+    for (auto& p : warmProbes) p = key(recs[rng() % n]);
+
+    // ---- cold: evict, then a short dependent chain; only the chain is timed ----
+    const int rounds = 100, chain = 256;
+    std::vector<char> scratch(64u << 20);
+    size_t eytzSink = 0, stdSink = 0;
+    double eytzMs = 0, stdMs = 0;
+    for (int r = 0; r < rounds; ++r) {
+        std::vector<K> batch(coldProbes.begin() + r * chain, coldProbes.begin() + (r + 1) * chain);
+        evict_caches(scratch);
+        eytzMs += chase_ms(batch, chain, eytzSearch, eytzSink);
+        evict_caches(scratch);
+        stdMs += chase_ms(batch, chain, stdSearch, stdSink);
+    }
+    printRow(bench, "eytzinger:" + column, 1, "cold_lookup", (double)rounds * chain, eytzMs);
+    printRow(bench, "std_lower_bound:" + column, 1, "cold_lookup", (double)rounds * chain, stdMs);
+
+    // ---- warm: small hot set, touched once before timing ----
+    const int warm = 1000000;
+    size_t warmup = 0;
+    chase_ms(warmProbes, (int)warmProbes.size() * 2, eytzSearch, warmup);
+    chase_ms(warmProbes, (int)warmProbes.size() * 2, stdSearch, warmup);
+    ms = chase_ms(warmProbes, warm, eytzSearch, eytzSink);
+    printRow(bench, "eytzinger:" + column, 1, "warm_lookup", (double)warm, ms);
+    ms = chase_ms(warmProbes, warm, stdSearch, stdSink);
+    printRow(bench, "std_lower_bound:" + column, 1, "warm_lookup", (double)warm, ms);
+
+    // ---- throughput: independent random probes over the whole column ----
+    const int independent = 1000000;
+    std::vector<K> probes(independent);
+    for (auto& p : probes) p = key(recs[rng() % n]);
+    size_t eytzSum = 0, stdSum = 0;
+    t0 = clk::now();
+    for (int q = 0; q < independent; ++q) eytzSum += eytz.lowerBound(probes[q]);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "eytzinger:" + column, 1, "lookup", (double)independent, ms);
+    t0 = clk::now();
+    for (int q = 0; q < independent; ++q) stdSum += stdSearch(probes[q]);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow(bench, "std_lower_bound:" + column, 1, "lookup", (double)independent, ms);
+
+    if (eytzSink != stdSink || eytzSum != stdSum) {
+        std::cerr << "Warning: eytzinger/lower_bound results differ on " << column << "\n";
+    }
+}
+
+void eytzinger(const VectorDataSource& data, int /*maxThreads*/) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    bench_column<double>(recs, "value", [](const FireRecord& r) { return r.numericValue; });
+    bench_column<int32_t>(recs, "utc_minutes", [](const FireRecord& r) { return (int32_t)r.utc_minutes; });
+    bench_column<int32_t>(recs, "aqi", [](const FireRecord& r) { return (int32_t)r.aqi; });
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,87 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/PolygonFilter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Jagged star polygon around (lat, lon) with a hole, roughly state-sized.
+static GeoShape synthetic_shape(std::mt19937_64& rng, double lat, double lon, double radius, int vertices) {
+    std::uniform_real_distribution<double> jitter(0.6, 1.0);
+    GeoShape shape;
+    GeoShape::Ring outer, hole;
+    for (int i = 0; i < vertices; ++i) {
+        const double a = 2.0 * 3.14159265358979323846 * i / vertices;
+        const double r = radius * jitter(rng);
+        outer.push_back({lon + r * std::cos(a), lat + r * std::sin(a)});
+    }
+    for (int i = 0; i < 32; ++i) {
+        const double a = -2.0 * 3.14159265358979323846 * i / 32;
+        hole.push_back({lon + 0.2 * radius * std::cos(a), lat + 0.2 * radius * std::sin(a)});
+    }
+    shape.rings = {outer, hole};
+    return shape;
+}
+
+// Grid-accelerated polygon filter vs ray casting every point against every edge.
+void geofence(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> lat(30.0, 45.0), lon(-120.0, -75.0), radius(2.0, 6.0);
+    std::vector<GeoShape> shapes;
+    for (int s = 0; s < 4; ++s) shapes.push_back(synthetic_shape(rng, lat(rng), lon(rng), radius(rng), 2000));
+
+    for (size_t s = 0; s < shapes.size(); ++s) {
+        auto t0 = clk::now();
+        PolygonFilter fence(shapes[s]);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        const std::string name = "grid_filter:shape" + std::to_string(s);
+        printRow("geofence", name, 1, "build", (double)fence.edgeCount(), ms);
+
+        for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+            const int saved = omp_get_max_threads();
+            omp_set_num_threads(t);
+#endif
+            t0 = clk::now();
+            const size_t inside = fence.filter(recs, data.sites()).size();
+            ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+#ifdef _OPENMP
+            omp_set_num_threads(saved);
+#endif
+            printRow("geofence", name, t, "filter_points", (double)recs.size(), ms);
+            if (t == maxThreads) std::cerr << name << ": " << inside << " rows inside, " << fence.boundaryCells() << " boundary cells\n";
+        }
+
+        // Point tests alone, over the site coordinates: grid vs ray casting
+        // against every edge
+        const SiteTable& sites = data.sites();
+        size_t exactInside = 0, gridInside = 0;
+        t0 = clk::now();
+        for (const auto& site : sites) gridInside += fence.contains(site.latitude, site.longitude);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("geofence", name, 1, "contains_points", (double)sites.size(), ms);
+
+        t0 = clk::now();
+        for (const auto& site : sites) exactInside += fence.containsExact(site.latitude, site.longitude);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("geofence", "ray_casting:shape" + std::to_string(s), 1, "contains_points", (double)sites.size(), ms);
+
+        if (exactInside != gridInside) std::cerr << "Warning: geofence grid/exact disagree on shape " << s << "\n";
+    }
+}
+
+} // namespace Benchmarks
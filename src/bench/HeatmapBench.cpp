@@ -0,0 +1,102 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/TilePyramid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Viewport heatmap queries from the tile pyramid vs aggregating raw records.
+void heatmap(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+
+    for (int t : threadSweep(maxThreads)) {
+        TilePyramid pyramid;
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        auto t0 = clk::now();
+        pyramid.build(recs, data.sites());
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("heatmap", "tile_pyramid", t, "build", (double)recs.size(), ms);
+    }
+
+    TilePyramid pyramid;
+    pyramid.build(recs, data.sites());
+
+    // Most frequent parameter, and the time span of the data
+    std::unordered_map<uint16_t, size_t> paramCounts;
+    int32_t tMin = recs.front().utc_minutes, tMax = tMin;
+    for (const auto& r : recs) {
+        ++paramCounts[r.parameter_id];
+        tMin = std::min(tMin, r.utc_minutes);
+        tMax = std::max(tMax, r.utc_minutes);
+    }
+    const uint16_t param = std::max_element(paramCounts.begin(), paramCounts.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+
+    // Random viewports (5-30 degrees) over CONUS and 24-hour windows
+    struct Viewport { double lat0, lat1, lon0, lon1; int32_t t0, t1; };
+    const int queries = 200;
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> lat(24.0, 50.0), lon(-125.0, -66.0), span(5.0, 30.0);
+    std::vector<Viewport> views(queries);
+    for (auto& v : views) {
+        v.lat0 = lat(rng); v.lat1 = v.lat0 + span(rng) / 2;
+        v.lon0 = lon(rng); v.lon1 = v.lon0 + span(rng);
+        v.t0 = tMin + (int32_t)(rng() % (uint64_t)std::max(1, tMax - tMin));
+        v.t1 = v.t0 + 24 * 60 - 1;
+    }
+
+    for (int level : {4, 7, 10}) {
+        size_t tileReadings = 0, rawReadings = 0;
+        auto t0 = clk::now();
+        for (const auto& v : views) {
+            for (const auto& tile : pyramid.query(level, param, v.lat0, v.lat1, v.lon0, v.lon1, v.t0, v.t1)) {
+                tileReadings += tile.stats.count;
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("heatmap", "tile_pyramid:L" + std::to_string(level), 1, "viewport_query", queries, ms);
+
+        // Raw baseline: same cells and hour buckets, aggregated per query
+        t0 = clk::now();
+        for (const auto& v : views) {
+            const uint32_t x0 = TilePyramid::cellX(v.lon0, level), x1 = TilePyramid::cellX(v.lon1, level);
+            const uint32_t y0 = TilePyramid::cellY(v.lat0, level), y1 = TilePyramid::cellY(v.lat1, level);
+            const int32_t h0 = v.t0 / 60, h1 = v.t1 / 60;
+            std::unordered_map<uint32_t, TileStats> cells;
+            for (const auto& r : recs) {
+                const SiteRecord& site = data.sites()[r.site_id];
+                if (r.parameter_id != param || r.utc_minutes < 0 || std::isnan(site.latitude) || std::isnan(site.longitude)) continue;
+                if (r.utc_minutes / 60 < h0 || r.utc_minutes / 60 > h1) continue;
+                uint32_t x = TilePyramid::cellX(site.longitude, level), y = TilePyramid::cellY(site.latitude, level);
+                if (x < x0 || x > x1 || y < y0 || y > y1) continue;
+                cells[(y << 16) | x].add(r);
+            }
+            for (const auto& [cell, stats] : cells) rawReadings += stats.count;
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("heatmap", "raw_scan:L" + std::to_string(level), 1, "viewport_query", queries, ms);
+
+        if (tileReadings != rawReadings) std::cerr << "Warning: heatmap tile/raw counts differ at level " << level << "\n";
+    }
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,107 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/IdwInterpolator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// IDW surface over CONUS at 0.05 degrees for the busiest hour: tiled simd
+// operator at 1..N threads, a 24-hour series, and brute force on a sample.
+void idw(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+
+    // PM2.5 when present, else the most frequent parameter
+    std::unordered_map<uint16_t, size_t> paramCounts;
+    for (const auto& r : recs) ++paramCounts[r.parameter_id];
+    uint16_t param = std::max_element(paramCounts.begin(), paramCounts.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+    const uint32_t pm = data.dictionaries().frozen.parameter.find("PM2.5");
+    if (pm != FrozenDictionary::kNotFound) param = (uint16_t)pm;
+
+    std::unordered_map<int32_t, size_t> hourCounts;
+    for (const auto& r : recs) if (r.parameter_id == param) ++hourCounts[r.utc_minutes / 60];
+    const int32_t hour = std::max_element(hourCounts.begin(), hourCounts.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+    const int32_t t0 = hour * 60, t1 = t0 + 60;
+
+    GridSpec grid;
+    grid.lat_min = 24.0; grid.lat_max = 50.0; grid.lon_min = -125.0; grid.lon_max = -66.0;
+    grid.rows = 520; grid.cols = 1180;
+    IdwOptions options;
+    const IdwInterpolator idw(recs, data.siteIndex());
+
+    Raster raster;
+    for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        auto start = clk::now();
+        raster = idw.interpolate(param, t0, t1, grid, options);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow("idw", "tiled_simd", t, "interpolate_cells", (double)grid.cells(), ms);
+
+        start = clk::now();
+        const size_t hours = idw.interpolateSeries(param, t0 - 23 * 60, t1, 60, grid, options).size();
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow("idw", "tiled_simd_series", t, "interpolate_cells", (double)(grid.cells() * hours), ms);
+    }
+
+    // Reference: per-site means by a record scan, then every site per cell
+    std::unordered_map<uint32_t, std::pair<double, uint32_t>> sums;
+    std::unordered_map<uint32_t, std::pair<float, float>> where;
+    for (const auto& r : recs) {
+        if (r.parameter_id != param || r.utc_minutes < t0 || r.utc_minutes >= t1 || std::isnan(r.value)) continue;
+        const SiteRecord& site = data.sites()[r.site_id];
+        if (std::isnan(site.latitude) || std::isnan(site.longitude)) continue;
+        auto& s = sums[r.site_id];
+        s.first += r.value;
+        ++s.second;
+        where.emplace(r.site_id, std::make_pair(site.latitude, site.longitude));
+    }
+    struct Reading { double lat, lon, value; };
+    std::vector<Reading> sites;
+    for (const auto& s : sums) sites.push_back({where[s.first].first, where[s.first].second, s.second.first / s.second.second});
+
+    const size_t stride = 97;
+    size_t sampled = 0, mismatches = 0;
+    auto start = clk::now();
+    std::vector<std::pair<double, double>> d(sites.size());
+    for (size_t cell = 0; cell < grid.cells(); cell += stride, ++sampled) {
+        const double lat = grid.cellLat((uint32_t)(cell / grid.cols)), lon = grid.cellLon((uint32_t)(cell % grid.cols));
+        for (size_t s = 0; s < sites.size(); ++s) d[s] = {SiteIndex::haversineKm(lat, lon, sites[s].lat, sites[s].lon), sites[s].value};
+        const size_t k = std::min(options.neighbors, d.size());
+        std::partial_sort(d.begin(), d.begin() + k, d.end());
+        double sw = 0.0, swv = 0.0;
+        for (size_t j = 0; j < k; ++j) {
+            const double w = 1.0 / std::max(d[j].first * d[j].first, 1e-12);
+            sw += w;
+            swv += w * d[j].second;
+        }
+        const double expect = swv / sw, got = raster.values[cell];
+        if (std::fabs(expect - got) > 1e-2 * std::max(1.0, std::fabs(expect))) ++mismatches;
+    }
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow("idw", "brute_force", 1, "interpolate_cells", (double)sampled, ms);
+
+    std::cerr << "idw: " << raster.sites << " reporting sites, " << sampled << " cells checked\n";
+    // Equidistant sites may rank differently; anything more is a bug
+    if (mismatches > sampled / 1000) std::cerr << "Warning: idw surface and brute force disagree on " << mismatches << " cells\n";
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,82 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/BPlusTree.h"
+#include "index/PointIndex.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <iostream>
+#include <random>
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+static const size_t kGroups[] = {1, 2, 4, 8, 16, 32};
+
+// Interleaved (AMAC) batch lookups vs one-at-a-time lookups, single thread:
+// 1M random keys into the (site, parameter, hour) hash index and into a
+// B+tree on (site, hour), at group sizes 1..32. Results must match the
+// sequential ones.
+void interleave(const VectorDataSource& data, int) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    const std::string bench = "interleave";
+    const size_t queries = 1000000;
+    std::mt19937_64 rng(13);
+    size_t mismatches = 0;
+
+    // Hash index; a tenth of the keys absent
+    PointIndex index;
+    index.build(recs);
+    std::vector<PointIndex::Key> keys(queries);
+    for (auto& k : keys) {
+        const FireRecord& r = recs[rng() % recs.size()];
+        k = {r.site_id, r.parameter_id, r.utc_minutes};
+        if (rng() % 10 == 0) k.utcMinutes += 60 * 24 * 365;
+    }
+    std::vector<uint32_t> expectRows(queries), rows(queries);
+    auto start = clk::now();
+    for (size_t q = 0; q < queries; ++q) expectRows[q] = index.lookup(keys[q].site, keys[q].parameter, keys[q].utcMinutes);
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "point_index:sequential", 1, "lookup", (double)queries, ms);
+    for (size_t g : kGroups) {
+        start = clk::now();
+        index.lookupBatch(keys.data(), queries, rows.data(), g);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, "point_index:amac", 1, "lookup_group_" + std::to_string(g), (double)queries, ms);
+        mismatches += rows != expectRows;
+    }
+
+    // B+tree on a (site, hour) composite key, so lookups spread over the
+    // leaves; lower bounds of random stored keys
+    int32_t firstHour = INT32_MAX;
+    for (const auto& r : recs) firstHour = std::min(firstHour, PointIndex::hour_of(r.utc_minutes));
+    std::vector<std::pair<int32_t, uint32_t>> pairs(recs.size());
+    for (size_t i = 0; i < recs.size(); ++i) {
+        pairs[i] = {(int32_t)(recs[i].site_id * 100000u + (uint32_t)(PointIndex::hour_of(recs[i].utc_minutes) - firstHour)), (uint32_t)i};
+    }
+    parallel_radix_sort(pairs);
+    BPlusTree<int32_t> tree;
+    tree.bulkLoad(pairs);
+    std::vector<int32_t> treeKeys(queries);
+    for (auto& v : treeKeys) v = pairs[rng() % pairs.size()].first;
+    std::vector<size_t> expectPos(queries), pos(queries);
+    start = clk::now();
+    for (size_t q = 0; q < queries; ++q) expectPos[q] = tree.lowerBound(treeKeys[q]);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "btree_site_hour:sequential", 1, "lower_bound", (double)queries, ms);
+    for (size_t g : kGroups) {
+        start = clk::now();
+        tree.lowerBoundBatch(treeKeys.data(), queries, pos.data(), g);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+        printRow(bench, "btree_site_hour:amac", 1, "lower_bound_group_" + std::to_string(g), (double)queries, ms);
+        mismatches += pos != expectPos;
+    }
+
+    if (mismatches) std::cerr << "Warning: interleave: " << mismatches << " batches disagree with sequential lookups\n";
+}
+
+} // namespace Benchmarks
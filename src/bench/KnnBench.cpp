@@ -0,0 +1,95 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/SiteIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// k nearest sites: k-d tree vs brute force over the site table vs scanning
+// every record (what answering the question took before the site index).
+void knn(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    const size_t k = 10;
+
+    for (int t : threadSweep(maxThreads)) {
+        SiteIndex index;
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        auto t0 = clk::now();
+        index.build(recs, data.sites());
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("knn", "site_index", t, "build", (double)recs.size(), ms);
+    }
+
+    const SiteIndex& index = data.siteIndex();
+    const auto& sites = index.sites();
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> lat(24.0, 50.0), lon(-125.0, -66.0);
+    const int queries = 10000;
+    std::vector<std::pair<double, double>> points(queries);
+    for (auto& p : points) p = {lat(rng), lon(rng)};
+
+    // ---- k-d tree, including latest readings via the per-site rows ----
+    std::vector<std::vector<uint32_t>> treeIds(queries);
+    auto t0 = clk::now();
+    for (int q = 0; q < queries; ++q) {
+        for (const auto& ns : data.kNearestSites(points[q].first, points[q].second, k)) treeIds[q].push_back(ns.site_id);
+    }
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow("knn", "kd_tree", 1, "k_nearest_sites", queries, ms);
+
+    // ---- brute force over the site table ----
+    size_t mismatches = 0;
+    t0 = clk::now();
+    for (int q = 0; q < queries; ++q) {
+        std::vector<std::pair<double, uint32_t>> d(sites.size());
+        for (size_t s = 0; s < sites.size(); ++s) {
+            d[s] = {SiteIndex::haversineKm(points[q].first, points[q].second, sites[s].latitude, sites[s].longitude),
+                    sites[s].site_id};
+        }
+        std::partial_sort(d.begin(), d.begin() + std::min(k, d.size()), d.end());
+        for (size_t i = 0; i < std::min(k, d.size()); ++i) {
+            if (i >= treeIds[q].size() || treeIds[q][i] != d[i].second) { ++mismatches; break; }
+        }
+    }
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow("knn", "site_table_scan", 1, "k_nearest_sites", queries, ms);
+
+    // ---- full record scan (few queries: each touches every row) ----
+    const int rawQueries = 20;
+    t0 = clk::now();
+    for (int q = 0; q < rawQueries; ++q) {
+        std::unordered_map<uint32_t, double> best;
+        for (const auto& r : recs) {
+            const SiteRecord& site = data.sites()[r.site_id];
+            double km = SiteIndex::haversineKm(points[q].first, points[q].second, site.latitude, site.longitude);
+            auto it = best.find(r.site_id);
+            if (it == best.end()) best.emplace(r.site_id, km);
+            else it->second = std::min(it->second, km);
+        }
+    }
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow("knn", "record_scan", 1, "k_nearest_sites", rawQueries, ms);
+
+    // Exact distance ties may order differently; anything more is a bug
+    if (mismatches > (size_t)queries / 1000) std::cerr << "Warning: k-d tree and brute force disagree on " << mismatches << " queries\n";
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,85 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/SiteIndex.h"
+#include "index/SpatioTemporalIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Radius-and-window queries: time-partitioned grid vs a full record scan.
+void near(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+
+    for (int t : threadSweep(maxThreads)) {
+        SpatioTemporalIndex index;
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        auto t0 = clk::now();
+        index.build(recs, data.sites());
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("near", "spatiotemporal_grid", t, "build", (double)recs.size(), ms);
+    }
+
+    int32_t tMin = recs.front().utc_minutes, tMax = tMin;
+    for (const auto& r : recs) { tMin = std::min(tMin, r.utc_minutes); tMax = std::max(tMax, r.utc_minutes); }
+
+    // Points at random monitors, 25-150 km radius, 1-24 hour windows
+    struct Query { double lat, lon, km; int32_t t0, t1; };
+    std::mt19937_64 rng(42);
+    const int queries = 1000;
+    std::vector<Query> qs(queries);
+    for (auto& q : qs) {
+        const FireRecord& r = recs[rng() % recs.size()];
+        q.lat = data.sites()[r.site_id].latitude;
+        q.lon = data.sites()[r.site_id].longitude;
+        q.km = 25.0 + (double)(rng() % 126);
+        q.t0 = tMin + (int32_t)(rng() % (uint64_t)std::max(1, tMax - tMin));
+        q.t1 = q.t0 + 60 * (int32_t)(1 + rng() % 24) - 1;
+    }
+
+    size_t indexRows = 0;
+    data.findNear(0, 0, 0, 0, 0);   // build outside the timed loop
+    auto t0 = clk::now();
+    for (const auto& q : qs) indexRows += data.findNear(q.lat, q.lon, q.km, q.t0, q.t1).size();
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow("near", "spatiotemporal_grid", 1, "find_near", queries, ms);
+    printRow("near", "spatiotemporal_grid", 1, "rows_returned", (double)indexRows, ms);
+
+    const int scanQueries = 50;
+    size_t scanRows = 0, checkRows = 0;
+    t0 = clk::now();
+    for (int i = 0; i < scanQueries; ++i) {
+        const Query& q = qs[i];
+        for (const auto& r : recs) {
+            if (r.utc_minutes < q.t0 || r.utc_minutes > q.t1) continue;
+            const SiteRecord& site = data.sites()[r.site_id];
+            if (SiteIndex::haversineKm(q.lat, q.lon, site.latitude, site.longitude) <= q.km) ++scanRows;
+        }
+    }
+    ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+    printRow("near", "record_scan", 1, "find_near", scanQueries, ms);
+
+    for (int i = 0; i < scanQueries; ++i) {
+        const Query& q = qs[i];
+        checkRows += data.findNear(q.lat, q.lon, q.km, q.t0, q.t1).size();
+    }
+    if (checkRows != scanRows) std::cerr << "Warning: findNear index/scan counts differ\n";
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,121 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "index/PointIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// (site, parameter, hour) point lookups: full scans vs std::unordered_map
+// vs the open-addressing PointIndex, scalar and batched. Builds and batched
+// lookups sweep 1..N threads; 1M keys, a tenth of them absent.
+void point(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    const std::string bench = "point";
+    const size_t queries = 1000000;
+
+    std::mt19937_64 rng(5);
+    std::vector<PointIndex::Key> keys(queries);
+    for (auto& k : keys) {
+        const FireRecord& r = recs[rng() % recs.size()];
+        k = {r.site_id, r.parameter_id, r.utc_minutes};
+        if (rng() % 10 == 0) k.utcMinutes += 60 * 24 * 365;   // a year later: absent
+    }
+
+    // Full scans for the first 20 keys
+    size_t scanned = 0;
+    auto start = clk::now();
+    for (size_t q = 0; q < 20; ++q) {
+        const int32_t hour = PointIndex::hour_of(keys[q].utcMinutes);
+        for (const auto& r : recs) {
+            scanned += (r.site_id == keys[q].site && r.parameter_id == keys[q].parameter && PointIndex::hour_of(r.utc_minutes) == hour) ? 1 : 0;
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "full_scan", 1, "lookup", 20.0, ms);
+
+    // std::unordered_map on the packed key, first row per key; also the reference
+    auto pack = [](uint32_t site, uint16_t parameter, int32_t utcMinutes) {
+        return (uint64_t)site << 32 ^ (uint64_t)parameter << 24 ^ (uint32_t)PointIndex::hour_of(utcMinutes);
+    };
+    start = clk::now();
+    std::unordered_map<uint64_t, uint32_t> map;
+    map.reserve(recs.size());
+    for (size_t i = 0; i < recs.size(); ++i) map.emplace(pack(recs[i].site_id, recs[i].parameter_id, recs[i].utc_minutes), (uint32_t)i);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "unordered_map", 1, "build", (double)recs.size(), ms);
+
+    std::vector<uint32_t> expect(queries);
+    start = clk::now();
+    for (size_t q = 0; q < queries; ++q) {
+        auto it = map.find(pack(keys[q].site, keys[q].parameter, keys[q].utcMinutes));
+        expect[q] = it == map.end() ? PointIndex::kNotFound : it->second;
+    }
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "unordered_map", 1, "lookup", (double)queries, ms);
+
+    PointIndex index;
+    for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        start = clk::now();
+        index.build(recs);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, "point_index", t, "build", (double)recs.size(), ms);
+    }
+    std::cerr << "point: " << index.size() << " rows in " << index.capacity() << " slots, " << index.memoryBytes()
+              << " bytes (unordered_map ~" << map.size() * (sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(void*))
+              + map.bucket_count() * sizeof(void*) << ")\n";
+
+    size_t mismatches = 0;
+    std::vector<uint32_t> rows(queries);
+    start = clk::now();
+    for (size_t q = 0; q < queries; ++q) rows[q] = index.lookup(keys[q].site, keys[q].parameter, keys[q].utcMinutes);
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "point_index", 1, "lookup", (double)queries, ms);
+    mismatches += rows != expect;
+
+    for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        std::fill(rows.begin(), rows.end(), 0);
+        start = clk::now();
+        const long long chunks = (long long)((queries + 4095) / 4096);
+        #pragma omp parallel for schedule(static)
+        for (long long c = 0; c < chunks; ++c) {
+            const size_t begin = (size_t)c * 4096, n = std::min<size_t>(4096, queries - begin);
+            index.lookupBatch(keys.data() + begin, n, rows.data() + begin);
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, "point_index_batch", t, "lookup", (double)queries, ms);
+        mismatches += rows != expect;
+    }
+
+    size_t indexed = 0;
+    for (size_t q = 0; q < 20; ++q) index.forEach(keys[q].site, keys[q].parameter, keys[q].utcMinutes, [&](uint32_t) { ++indexed; });
+    mismatches += indexed != scanned;
+    if (mismatches) std::cerr << "Warning: point: " << mismatches << " lookup passes disagree with std::unordered_map or a scan\n";
+}
+
+} // namespace Benchmarks
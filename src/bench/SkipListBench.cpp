@@ -0,0 +1,111 @@
+#include "bench/Benchmarks.h"
+#include "implementations/MapDataSource.h"
+#include "implementations/VectorDataSource.h"
+#include "index/ConcurrentSkipList.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+// Mutex-protected std::map baseline: every insert and scan takes the lock.
+struct LockedMap {
+    std::map<RowKey<double>, uint32_t> map;
+    std::mutex mu;
+};
+
+namespace {
+
+// Contention is the point, so the sweep runs to 64 threads even past the
+// core count (oversubscribed there)
+constexpr int kMinSweepThreads = 64;
+
+// Keys are (values[i], i): the unified value of each loaded row
+void run_skiplist(const std::vector<double>& values, int maxThreads) {
+    const long long n = (long long)values.size();
+    if (n == 0) return;
+
+    // Range queries over composite keys, each returning exactly `span` rows
+    // (value ranges alone would hit runs of thousands of equal values).
+    std::vector<RowKey<double>> sorted((size_t)n);
+    for (long long i = 0; i < n; ++i) sorted[i] = RowKey<double>{values[i], (uint32_t)i};
+    std::sort(sorted.begin(), sorted.end());
+    const int queries = 100000;
+    const size_t span = 100;
+    std::vector<RowKey<double>> qlo(queries), qhi(queries);
+    std::mt19937_64 rng(42);
+    for (int q = 0; q < queries; ++q) {
+        size_t i = rng() % (sorted.size() - span);
+        qlo[q] = sorted[i];
+        qhi[q] = sorted[i + span - 1];
+    }
+
+    for (int t : threadSweep(std::max(maxThreads, kMinSweepThreads))) {
+        // ---- lock-free skip list ----
+        ConcurrentSkipList<RowKey<double>, uint32_t> list;
+        auto t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static)
+        for (long long i = 0; i < n; ++i) list.insert(RowKey<double>{values[i], (uint32_t)i}, (uint32_t)i);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("skiplist", "lockfree_skiplist", t, "insert", (double)n, ms);
+
+        long long hits = 0;
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(dynamic, 64) reduction(+:hits)
+        for (int q = 0; q < queries; ++q) {
+            list.scan(qlo[q], qhi[q], [&](const RowKey<double>&, uint32_t) { ++hits; });
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("skiplist", "lockfree_skiplist", t, "range_scan", (double)queries, ms);
+
+        // ---- mutex-protected std::map ----
+        LockedMap locked;
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            std::lock_guard<std::mutex> lock(locked.mu);
+            locked.map.emplace(RowKey<double>{values[i], (uint32_t)i}, (uint32_t)i);
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("skiplist", "mutex_std_map", t, "insert", (double)n, ms);
+
+        long long mapHits = 0;
+        t0 = clk::now();
+        #pragma omp parallel for num_threads(t) schedule(dynamic, 64) reduction(+:mapHits)
+        for (int q = 0; q < queries; ++q) {
+            std::lock_guard<std::mutex> lock(locked.mu);
+            auto it = locked.map.lower_bound(qlo[q]);
+            auto end = locked.map.upper_bound(qhi[q]);
+            for (; it != end; ++it) ++mapHits;
+        }
+        ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        printRow("skiplist", "mutex_std_map", t, "range_scan", (double)queries, ms);
+
+        if (hits != mapHits) std::cerr << "Warning: skiplist/map range results differ\n";
+    }
+}
+
+} // namespace
+
+void skipList(const VectorDataSource& data, int maxThreads) {
+    std::vector<double> values;
+    values.reserve(data.fireRecords().size());
+    for (const auto& r : data.fireRecords()) values.push_back(r.numericValue);
+    run_skiplist(values, maxThreads);
+}
+
+// Same benchmark over the map source's rows, in list order
+void skipListMap(const MapDataSource& data, int maxThreads) {
+    std::vector<double> values;
+    values.reserve(data.fireRecords().size());
+    for (const auto& r : data.fireRecords()) values.push_back(r.numericValue);
+    run_skiplist(values, maxThreads);
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,85 @@
+#include "bench/Benchmarks.h"
+#include "implementations/VectorDataSource.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#if defined(HAS_PAR_STL) && __has_include(<execution>)
+#include <execution>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using clk = std::chrono::steady_clock;
+
+namespace Benchmarks {
+
+template <typename K, typename KeyFn>
+static void bench_keys(const FireRecords& recs, const std::string& column, KeyFn key, int maxThreads) {
+    const std::string bench = "sort";
+    std::vector<std::pair<K, uint32_t>> input(recs.size());
+    for (size_t i = 0; i < recs.size(); ++i) input[i] = {key(recs[i]), (uint32_t)i};
+    const double n = (double)input.size();
+    auto byKey = [](const std::pair<K, uint32_t>& a, const std::pair<K, uint32_t>& b) { return a.first < b.first; };
+
+    // Stable by key; also the reference order for the others
+    auto expect = input;
+    auto start = clk::now();
+    std::stable_sort(expect.begin(), expect.end(), byKey);
+    double ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "std_stable_sort:" + column, 1, "sort_pairs", n, ms);
+
+    // (key, row) pair order equals the stable order since rows start ascending
+    auto pairs = input;
+    start = clk::now();
+    std::sort(pairs.begin(), pairs.end());
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "std_sort:" + column, 1, "sort_pairs", n, ms);
+
+    for (int t : threadSweep(maxThreads)) {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(t);
+#endif
+        pairs = input;
+        start = clk::now();
+        parallel_radix_sort(pairs);
+        ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+        printRow(bench, "radix_lsd:" + column, t, "sort_pairs", n, ms);
+        if (pairs != expect) std::cerr << "Warning: radix sort of " << column << " differs from std::stable_sort\n";
+    }
+
+#if defined(HAS_PAR_STL) && defined(__cpp_lib_parallel_algorithm)
+    // The execution policy sizes its own pool (all cores)
+    pairs = input;
+    start = clk::now();
+    std::sort(std::execution::par, pairs.begin(), pairs.end());
+    ms = std::chrono::duration<double, std::milli>(clk::now() - start).count();
+    printRow(bench, "std_sort_par:" + column, maxThreads, "sort_pairs", n, ms);
+#endif
+}
+
+// (key, row) pair sorts as the index and clustering builders run them:
+// std::sort / std::stable_sort, std::execution::par when available, and
+// the parallel LSD radix sort at 1..N threads.
+void radixSort(const VectorDataSource& data, int maxThreads) {
+    const FireRecords& recs = data.fireRecords();
+    if (recs.empty()) return;
+    bench_keys<float>(recs, "value_f32", [](const FireRecord& r) { return std::isnan(r.value) ? 0.0f : r.value; }, maxThreads);
+    bench_keys<double>(recs, "value_f64", [](const FireRecord& r) { return r.numericValue; }, maxThreads);
+    bench_keys<int32_t>(recs, "utc_i32", [](const FireRecord& r) { return r.utc_minutes; }, maxThreads);
+    bench_keys<uint32_t>(recs, "site_u32", [](const FireRecord& r) { return r.site_id; }, maxThreads);
+#if !defined(HAS_PAR_STL) || !defined(__cpp_lib_parallel_algorithm)
+    std::cerr << "sort: std::execution::par not available in this build (needs TBB)\n";
+#endif
+}
+
+} // namespace Benchmarks
@@ -1,16 +1,19 @@
 #include "DataSourceFactory.h"
 #include "../implementations/VectorDataSource.h"
 #include "../implementations/MapDataSource.h"
+#include "../implementations/RawDataSource.h"
 #include <algorithm>
 
 namespace DataSourceFactory {
 
-std::unique_ptr<IDataSource> create(const std::string& type, const std::string& filePath) {
+std::unique_ptr<IDataSource> create(const std::string& type, const std::string& filePath,
+                                    const LoadOptions& options) {
     std::string t = type;
     for (auto& c : t) c = (char)std::tolower((unsigned char)c);
 
-    if (t == "vector") return std::make_unique<VectorDataSource>(filePath);
-    if (t == "map")    return std::make_unique<MapDataSource>(filePath);
+    if (t == "vector") return std::make_unique<VectorDataSource>(filePath, options);
+    if (t == "map")    return std::make_unique<MapDataSource>(filePath, options);
+    if (t == "raw")    return std::make_unique<RawDataSource>(filePath, options);
 
     return nullptr;
 }
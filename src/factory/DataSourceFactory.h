@@ -2,8 +2,10 @@
 #include <memory>
 #include <string>
 #include "../interfaces/IDataSource.h"
+#include "../interfaces/LoadOptions.h"
 
 namespace DataSourceFactory {
-    // Create a data source ("vector" or "map") for a given file path.
-    std::unique_ptr<IDataSource> create(const std::string& type, const std::string& filePath);
+    // Create a data source ("vector", "map" or "raw") for a given file path.
+    std::unique_ptr<IDataSource> create(const std::string& type, const std::string& filePath,
+                                        const LoadOptions& options = {});
 }
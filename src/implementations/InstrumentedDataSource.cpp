@@ -0,0 +1,63 @@
+#include "InstrumentedDataSource.h"
+
+#include <chrono>
+
+using clk = std::chrono::steady_clock;
+
+InstrumentedDataSource::InstrumentedDataSource(std::unique_ptr<IDataSource> inner, const std::string& impl)
+    : inner_(std::move(inner)), impl_(impl)
+{
+    range_ = register_op("findByRange");
+    min_   = register_op("findMin");
+    max_   = register_op("findMax");
+    sum_   = register_op("sumByYear");
+}
+
+InstrumentedDataSource::OpMetrics InstrumentedDataSource::register_op(const std::string& op) {
+    auto& reg = MetricsRegistry::instance();
+    const std::string labels = "impl=\"" + impl_ + "\",op=\"" + op + "\"";
+    OpMetrics m;
+    m.queries = &reg.counter("mini1_queries_total", "Queries executed", labels);
+    m.rows    = &reg.counter("mini1_query_rows_returned_total", "Rows returned by queries", labels);
+    m.latency = &reg.histogram("mini1_query_latency_seconds", "Query latency", labels);
+    return m;
+}
+
+static inline double seconds_since(clk::time_point t0) {
+    return std::chrono::duration<double>(clk::now() - t0).count();
+}
+
+RecordViews InstrumentedDataSource::findByRange(Column col, const std::string& minVal, const std::string& maxVal) {
+    auto t0 = clk::now();
+    RecordViews out = inner_->findByRange(col, minVal, maxVal);
+    range_.latency->observe(seconds_since(t0));
+    range_.queries->inc();
+    range_.rows->inc(out.size());
+    return out;
+}
+
+std::optional<RecordView> InstrumentedDataSource::findMin() {
+    auto t0 = clk::now();
+    auto out = inner_->findMin();
+    min_.latency->observe(seconds_since(t0));
+    min_.queries->inc();
+    if (out) min_.rows->inc();
+    return out;
+}
+
+std::optional<RecordView> InstrumentedDataSource::findMax() {
+    auto t0 = clk::now();
+    auto out = inner_->findMax();
+    max_.latency->observe(seconds_since(t0));
+    max_.queries->inc();
+    if (out) max_.rows->inc();
+    return out;
+}
+
+double InstrumentedDataSource::sumByYear(int year) {
+    auto t0 = clk::now();
+    double out = inner_->sumByYear(year);
+    sum_.latency->observe(seconds_since(t0));
+    sum_.queries->inc();
+    return out;
+}
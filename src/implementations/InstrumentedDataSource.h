@@ -0,0 +1,28 @@
+#pragma once
+#include "../interfaces/IDataSource.h"
+#include "../utility/Metrics.h"
+#include <memory>
+#include <string>
+
+// Proxy that records query counts and latencies for any IDataSource.
+class InstrumentedDataSource : public IDataSource {
+public:
+    InstrumentedDataSource(std::unique_ptr<IDataSource> inner, const std::string& impl);
+
+    RecordViews findByRange(Column col, const std::string& minVal, const std::string& maxVal) override;
+    std::optional<RecordView> findMin() override;
+    std::optional<RecordView> findMax() override;
+    double sumByYear(int year) override;
+
+private:
+    struct OpMetrics {
+        Counter* queries = nullptr;
+        Counter* rows = nullptr;
+        Histogram* latency = nullptr;
+    };
+    OpMetrics register_op(const std::string& op);
+
+    std::unique_ptr<IDataSource> inner_;
+    std::string impl_;
+    OpMetrics range_, min_, max_, sum_;
+};
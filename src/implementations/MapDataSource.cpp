@@ -1,7 +1,10 @@
 #include "MapDataSource.h"
 #include "../utility/CSVParser.h"
+#include "../utility/LoadPlanner.h"
+#include "../utility/Metrics.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cctype>
 #include <cstdlib>
 #include <ctime>
@@ -42,7 +45,9 @@ bool MapDataSource::to_int(const std::string& s, int& out){ if(s.empty()) return
 bool MapDataSource::to_double(const std::string& s, double& out){ if(s.empty()) return false; try{ out=std::stod(s); return true;}catch(...){return false;}}
 
 // -------- construction / load --------
-MapDataSource::MapDataSource(const std::string& filePath) {
+MapDataSource::MapDataSource(const std::string& filePath, const LoadOptions& options)
+    : options_(options), ingest_lag_("impl=\"map\"")
+{
     namespace fs = std::filesystem;
 
     auto load_single = [&](const std::string& path) {
@@ -70,82 +75,20 @@ MapDataSource::MapDataSource(const std::string& filePath) {
     std::error_code ec;
     fs::file_status st = fs::status(filePath, ec);
     if (!ec && fs::is_directory(st)) {
-        bool datasetInitialized = false;
-        std::vector<std::string> firstHeader;
-        Dataset firstDataset = Dataset::WorldBank;
-
-        for (auto const& entry : fs::recursive_directory_iterator(filePath, ec)) {
-            if (ec) break;
-            if (!entry.is_regular_file()) continue;
-            const auto& p = entry.path();
-            if (p.extension() != ".csv") continue;
-
-            if (!datasetInitialized) {
-                CSVParser csv(p.string(), /*hasHeader=*/true);
-                bool hasHdr = csv.readHeader(firstHeader);
-                if (hasHdr && isPopulationHeader(firstHeader)) firstDataset = Dataset::WorldBank;
-                else {
-                    // peek first row to detect Fire vs WB
-                    std::vector<std::string> row;
-                    if (csv.next(row) && looksLikeFireRow(row)) firstDataset = Dataset::Fire;
-                    else firstDataset = Dataset::WorldBank;
-                }
-                dataset_ = firstDataset;
-                datasetInitialized = true;
-            }
-
-            if (dataset_ == Dataset::WorldBank) {
-                load_worldbank_data(p.string());
-            } else if (dataset_ == Dataset::Fire) {
-                load_fire_data(p.string());
-            }
-        }
+        // Same discovery and LPT scheduling as VectorDataSource
+        load_directory(LoadPlanner::discover(filePath));
     } else {
         load_single(filePath);
     }
-}
+    finalize_dictionaries();
 
-// ---- Fire helpers ----
-uint32_t MapDataSource::dict_get_or_add(std::unordered_map<std::string, uint32_t>& dict, const std::string& key) {
-    auto it = dict.find(key);
-    if (it != dict.end()) return it->second;
-    uint32_t id = (uint32_t)dict.size();
-    dict.emplace(key, id);
-    
-    // Update reverse lookup vector
-    if (&dict == &dictionaries_.parameter_dict) {
-        dictionaries_.parameter_names.push_back(key);
-    } else if (&dict == &dictionaries_.unit_dict) {
-        dictionaries_.unit_names.push_back(key);
-    } else if (&dict == &dictionaries_.site_dict) {
-        dictionaries_.site_names.push_back(key);
-    } else if (&dict == &dictionaries_.agency_dict) {
-        dictionaries_.agency_names.push_back(key);
-    } else if (&dict == &dictionaries_.aqs_dict) {
-        dictionaries_.aqs_names.push_back(key);
-    } else if (&dict == &dictionaries_.country_name_dict) {
-        dictionaries_.country_names.push_back(key);
-    } else if (&dict == &dictionaries_.country_code_dict) {
-        dictionaries_.country_codes.push_back(key);
+    if (options_.orderedIndex == LoadOptions::OrderedIndex::SkipList && dataset_ == Dataset::Fire) {
+        build_value_index();
     }
-    
-    return id;
-}
-
-uint16_t MapDataSource::dict_get_or_add(std::unordered_map<std::string, uint16_t>& dict, const std::string& key) {
-    auto it = dict.find(key);
-    if (it != dict.end()) return it->second;
-    uint16_t id = (uint16_t)dict.size();
-    dict.emplace(key, id);
-    
-    // Update reverse lookup vector
-    if (&dict == &dictionaries_.indicator_dict) {
-        dictionaries_.indicator_names.push_back(key);
-    }
-    
-    return id;
+    publish_load_metrics();
 }
 
+// ---- Fire helpers ----
 static inline int to_int2(const std::string& s) { return std::atoi(s.c_str()); }
 
 long long MapDataSource::parse_utc_minutes(const std::string& utc) {
@@ -168,7 +111,32 @@ long long MapDataSource::parse_utc_minutes(const std::string& utc) {
 }
 
 void MapDataSource::load_fire_data(const std::string& path) {
-    CSVParser csv(path, /*hasHeader=*/false);
+    LoadTask task; task.path = path; task.end = UINT64_MAX;
+    parse_fire_file(task, fire_records_, dictionaries_);
+}
+
+size_t MapDataSource::parse_fire_file(const LoadTask& task, std::list<FireRecord>& out, Dictionaries& dicts) {
+    const size_t before = out.size();
+    CSVParser csv(task.path, /*hasHeader=*/false);
+    csv.setRange(task.begin, task.end);
+    // Projection: fields outside it are delimited, never copied or converted;
+    // skipped dictionary columns all take the empty name's id
+    const uint32_t fields = options_.fireFields | fire_field_bit(FireField::Latitude) | fire_field_bit(FireField::Longitude);
+    auto loads = [fields](FireField f) { return (fields & fire_field_bit(f)) != 0; };
+    csv.setFields(fields);
+    auto encode = [&](FireField f, std::unordered_map<std::string, uint32_t>& dict, std::vector<std::string>& names) {
+        const uint32_t skipped = loads(f) ? 0 : dict_get_or_add_named(dict, names, std::string());
+        return [&dict, &names, skipped, load = loads(f)](const std::string& name) {
+            return load ? dict_get_or_add_named(dict, names, name) : skipped;
+        };
+    };
+    auto parameterOf = encode(FireField::Parameter, dicts.parameter_dict, dicts.parameter_names);
+    auto unitOf      = encode(FireField::Unit, dicts.unit_dict, dicts.unit_names);
+    auto siteNameOf  = encode(FireField::SiteName, dicts.site_dict, dicts.site_names);
+    auto agencyOf    = encode(FireField::Agency, dicts.agency_dict, dicts.agency_names);
+    auto aqsOf       = encode(FireField::Aqs, dicts.aqs_dict, dicts.aqs_names);
+
+    int32_t newest = INT32_MIN;
     std::vector<std::string> row;
     while (csv.next(row)) {
         if (row.size() < 12) continue;
@@ -180,8 +148,8 @@ void MapDataSource::load_fire_data(const std::string& path) {
         
         const std::string& utc = row[2];
         long long utc_minutes = parse_utc_minutes(utc);
-        uint32_t paramId = dict_get_or_add(dictionaries_.parameter_dict, row[3]);
-        uint32_t unitId  = dict_get_or_add(dictionaries_.unit_dict, row[5]);
+        uint32_t paramId = parameterOf(row[3]);
+        uint32_t unitId  = unitOf(row[5]);
         
         float value = std::numeric_limits<float>::quiet_NaN(); 
         if (!row[4].empty() && to_double(row[4], value_d) && value_d != -999.0) value = (float)value_d;
@@ -190,48 +158,204 @@ void MapDataSource::load_fire_data(const std::string& path) {
         
         int aqi = -999; if (!row[7].empty()) { int v=0; if (to_int(row[7], v)) aqi = v; }
         uint8_t cat = 0; if (!row[8].empty()) { int v=0; if (to_int(row[8], v)) cat = (uint8_t)v; }
-        uint32_t siteId   = dict_get_or_add(dictionaries_.site_dict, row[9]);
-        uint32_t agencyId = dict_get_or_add(dictionaries_.agency_dict, row[10]);
-        uint32_t aqsId    = dict_get_or_add(dictionaries_.aqs_dict, row[11]);
+        // Static monitor attributes go to the site dimension; the row keeps its id
+        SiteRecord site;
+        site.latitude  = lat;
+        site.longitude = lon;
+        site.name_id   = siteNameOf(row[9]);
+        site.agency_id = agencyOf(row[10]);
+        site.aqs_id    = aqsOf(row[11]);
+        uint32_t siteId = site_get_or_add(dicts, site);
 
         // Derived fields
         int yr = 0;
         if (utc.size()>=4) { int v=0; if (to_int(utc.substr(0,4), v)) yr = v; }
         double numericVal = std::isnan(value) ? 0.0 : value;
+        newest = std::max(newest, (int32_t)utc_minutes);
 
         // Direct construction in place (no copy)
-        fire_records_.emplace_back(lat, lon, (int32_t)utc_minutes, (uint16_t)paramId, (uint16_t)unitId,
-                                  value, raw, (int16_t)aqi, cat, siteId, agencyId, aqsId, yr, numericVal);
+        out.emplace_back((int32_t)utc_minutes, (uint16_t)paramId, (uint16_t)unitId,
+                         value, raw, (int16_t)aqi, cat, siteId, yr, numericVal);
     }
+    record_file_ingested(out.size() - before, task.firstChunk ? 1 : 0, newest);
+    return out.size() - before;
 }
 
 void MapDataSource::load_worldbank_data(const std::string& path) {
-    CSVParser csv(path, /*hasHeader=*/true);
+    LoadTask task; task.path = path; task.end = UINT64_MAX;
+    parse_worldbank_file(task, worldbank_records_, dictionaries_);
+}
+
+size_t MapDataSource::parse_worldbank_file(const LoadTask& task, std::list<WorldBankRecord>& out, Dictionaries& dicts) {
+    const size_t before = out.size();
+    CSVParser csv(task.path, /*hasHeader=*/true);
     std::vector<std::string> header;
     csv.readHeader(header);
 
     std::vector<std::string> row;
-        while (csv.next(row)) {
-            if (row.size() < 5) continue;
-            const std::string countryName = row[0];
-            const std::string countryCode = row[1];
+    while (csv.next(row)) {
+        if (row.size() < 5) continue;
+        const std::string countryName = row[0];
+        const std::string countryCode = row[1];
         const std::string indicatorName = row[2];
         const std::string indicatorCode = row[3];
 
-        uint32_t cn_id = dict_get_or_add(dictionaries_.country_name_dict, countryName);
-        uint32_t cc_id = dict_get_or_add(dictionaries_.country_code_dict, countryCode);
-        uint16_t indicator_id = dict_get_or_add(dictionaries_.indicator_dict, indicatorName + "|" + indicatorCode);
+        uint32_t cn_id = dict_get_or_add_named(dicts.country_name_dict, dicts.country_names, countryName);
+        uint32_t cc_id = dict_get_or_add_named(dicts.country_code_dict, dicts.country_codes, countryCode);
+        uint16_t indicator_id = dict_get_or_add_named(dicts.indicator_dict, dicts.indicator_names, indicatorName + "|" + indicatorCode);
 
-            for (size_t c=4; c<row.size(); ++c) {
+        for (size_t c=4; c<row.size(); ++c) {
             if (c < header.size() && header[c].size()==4 && (header[c][0] >= '0' && header[c][0] <= '9')) {
-                    int yr=0; if (!to_int(header[c], yr)) continue;
-                    double val; if (row[c].empty() || !to_double(row[c], val)) continue;
+                int yr=0; if (!to_int(header[c], yr)) continue;
+                double val; if (row[c].empty() || !to_double(row[c], val)) continue;
 
                 // Direct construction in place (no copy)
-                worldbank_records_.emplace_back(cn_id, cc_id, indicator_id, (int16_t)yr, val, val);
+                out.emplace_back(cn_id, cc_id, indicator_id, (int16_t)yr, val, val);
             }
         }
     }
+    record_file_ingested(out.size() - before, task.firstChunk ? 1 : 0);
+    return out.size() - before;
+}
+
+// -------- parallel directory load --------
+// Each task fills its own list with its own dictionaries (largest task
+// first); lists are remapped in parallel and spliced in directory order,
+// which is O(1) per task and gives the same order as a serial load.
+template <typename Rec, typename ParseFn>
+static std::vector<std::list<Rec>> parse_into_lists(const std::vector<LoadTask>& tasks,
+                                                    std::vector<Dictionaries>& taskDicts,
+                                                    std::vector<double>& threadFinish, ParseFn parse)
+{
+    std::vector<std::list<Rec>> lists(tasks.size());
+    const std::vector<size_t> order = LoadPlanner::largestFirst(tasks);
+    const long long n = (long long)order.size();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 1) nowait
+        for (long long k = 0; k < n; ++k) {
+            const size_t i = order[k];
+            parse(tasks[i], lists[i], taskDicts[i]);
+        }
+        double done = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        #pragma omp critical
+        threadFinish.push_back(done);
+    }
+    return lists;
+}
+
+template <typename Rec>
+static void remap_and_splice(std::vector<std::list<Rec>>& lists, const std::vector<DictionaryRemap>& remaps,
+                             std::list<Rec>& out)
+{
+    const long long n = (long long)lists.size();
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long i = 0; i < n; ++i) {
+        for (auto& rec : lists[i]) remaps[i].apply(rec);
+    }
+    for (auto& l : lists) out.splice(out.end(), l);
+}
+
+// Name-ordered ids, so id ranges are name ranges. List nodes are gathered
+// first so the rows remap in parallel.
+void MapDataSource::finalize_dictionaries() {
+    const DictionaryRemap remap = sort_dictionaries(dictionaries_);
+    auto apply_all = [&](auto& list) {
+        std::vector<decltype(&list.front())> nodes;
+        nodes.reserve(list.size());
+        for (auto& rec : list) nodes.push_back(&rec);
+        const long long n = (long long)nodes.size();
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; ++i) remap.apply(*nodes[i]);
+    };
+    if (dataset_ == Dataset::Fire) apply_all(fire_records_);
+    else apply_all(worldbank_records_);
+    freeze_dictionaries(dictionaries_);
+}
+
+void MapDataSource::load_directory(const std::vector<LoadTask>& files) {
+    if (files.empty()) return;
+
+    // Sniff the dataset from the first line of the first file
+    std::string firstLine;
+    CSVParser::countLines(files.front().path, 0, 64 * 1024, &firstLine);
+    std::vector<std::string> first;
+    CSVParser::splitLine(firstLine, first);
+    dataset_ = (isPopulationHeader(first) || !looksLikeFireRow(first)) ? Dataset::WorldBank : Dataset::Fire;
+
+    // Headered WorldBank files cannot be split into chunks
+    const std::vector<LoadTask> tasks = dataset_ == Dataset::Fire
+        ? LoadPlanner::splitOversized(files, options_.chunkBytes) : files;
+    std::vector<Dictionaries> taskDicts(tasks.size());
+    std::vector<double> threadFinish;
+
+    if (dataset_ == Dataset::Fire) {
+        auto lists = parse_into_lists<FireRecord>(tasks, taskDicts, threadFinish,
+            [this](const LoadTask& t, std::list<FireRecord>& out, Dictionaries& d) { parse_fire_file(t, out, d); });
+        remap_and_splice(lists, merge_dictionaries(dictionaries_, taskDicts), fire_records_);
+    } else {
+        auto lists = parse_into_lists<WorldBankRecord>(tasks, taskDicts, threadFinish,
+            [this](const LoadTask& t, std::list<WorldBankRecord>& out, Dictionaries& d) { parse_worldbank_file(t, out, d); });
+        remap_and_splice(lists, merge_dictionaries(dictionaries_, taskDicts), worldbank_records_);
+    }
+
+    MetricsRegistry::instance()
+        .gauge("mini1_load_tail_seconds", "Parse phase: last thread finish minus median thread finish", "impl=\"map\"")
+        .set(LoadPlanner::tailSeconds(threadFinish));
+}
+
+// -------- ordered index --------
+void MapDataSource::build_value_index() {
+    // Row ids follow list order; inserts run concurrently into the lock-free list
+    std::vector<const FireRecord*> rows;
+    rows.reserve(fire_records_.size());
+    for (const auto& record : fire_records_) rows.push_back(&record);
+
+    value_index_ = std::make_unique<ValueIndex>();
+    const long long n = (long long)rows.size();
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; ++i) {
+        value_index_->insert(RowKey<double>{rows[i]->numericValue, (uint32_t)i}, rows[i]);
+    }
+}
+
+// -------- metrics --------
+void MapDataSource::record_file_ingested(size_t rows, size_t files, int32_t newestUtc) const {
+    static Counter& filesIngested = MetricsRegistry::instance().counter(
+        "mini1_files_ingested_total", "CSV files ingested", "impl=\"map\"");
+    static Counter& rowsIngested = MetricsRegistry::instance().counter(
+        "mini1_rows_ingested_total", "Records ingested", "impl=\"map\"");
+    filesIngested.inc(files);
+    rowsIngested.inc(rows);
+
+    // Live ingest lag, as tasks finish; publish_load_metrics sets the final value
+    if (newestUtc != INT32_MIN) ingest_lag_.observe(newestUtc);
+}
+
+void MapDataSource::publish_load_metrics() const {
+    auto& reg = MetricsRegistry::instance();
+    const std::string impl = "impl=\"map\"";
+    reg.gauge("mini1_records", "Records held", impl)
+        .set((double)(dataset_ == Dataset::Fire ? fire_records_.size() : worldbank_records_.size()));
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"fire_records\"")
+        .set((double)(fire_records_.size() * (sizeof(FireRecord) + 2 * sizeof(void*))));
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"worldbank_records\"")
+        .set((double)(worldbank_records_.size() * (sizeof(WorldBankRecord) + 2 * sizeof(void*))));
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"dictionaries\"")
+        .set((double)dictionaries_memory_bytes(dictionaries_));
+    if (value_index_) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"value_index\"")
+            .set((double)value_index_->memoryBytes());
+    }
+
+    // Ingest lag: wall clock minus the newest observation timestamp
+    if (dataset_ == Dataset::Fire && !fire_records_.empty()) {
+        int32_t newest = std::max_element(fire_records_.begin(), fire_records_.end(),
+            [](const FireRecord& a, const FireRecord& b) { return a.utc_minutes < b.utc_minutes; })->utc_minutes;
+        ingest_lag_.observe(newest);
+    }
 }
 
 // -------- conversion helpers --------
@@ -240,15 +364,16 @@ RecordView MapDataSource::fire_to_view(const FireRecord& record) const {
     view.type = RecordView::Type::Fire;
     view.year = record.year;
     view.numericValue = record.numericValue;
-    view.latitude = record.latitude;
-    view.longitude = record.longitude;
+    const SiteRecord& site = dictionaries_.sites[record.site_id];
+    view.latitude = site.latitude;
+    view.longitude = site.longitude;
     view.value = record.value;
     view.aqi = record.aqi;
     view.parameter_id = record.parameter_id;
     view.unit_id = record.unit_id;
-    view.site_id = record.site_id;
-    view.agency_id = record.agency_id;
-    view.aqs_id = record.aqs_id;
+    view.site_id = site.name_id;
+    view.agency_id = site.agency_id;
+    view.aqs_id = site.aqs_id;
     return view;
 }
 
@@ -266,12 +391,20 @@ RecordView MapDataSource::worldbank_to_view(const WorldBankRecord& record) const
 // -------- column-aware API (all scans) --------
 RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const std::string& hiS) {
     RecordViews results;
+    // Projected out at load: the rows only hold defaults for col
+    if (dataset_ == Dataset::Fire && !options_.loadsColumn(col)) return {};
     
     if (dataset_ == Dataset::Fire) {
         // Fire-specific queries
         switch (col) {
             case Column::Value: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                if (value_index_) {
+                    // Index order: by value, then load order
+                    value_index_->scan(RowKey<double>{lo, 0}, RowKey<double>{hi, UINT32_MAX},
+                        [&](const RowKey<double>&, const FireRecord* record) { results.push_back(fire_to_view(*record)); });
+                    break;
+                }
                 for (const auto& record : fire_records_) {
                     if (record.numericValue >= lo && record.numericValue <= hi) {
                         results.push_back(fire_to_view(record));
@@ -280,18 +413,21 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
                 break;
             }
             case Column::Latitude: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                // Site attribute: test each dimension row once, then rows by site_id
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return s.latitude >= lo && s.latitude <= hi; });
                 for (const auto& record : fire_records_) {
-                    if (record.latitude >= lo && record.latitude <= hi) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
                 }
                 break;
             }
             case Column::Longitude: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return s.longitude >= lo && s.longitude <= hi; });
                 for (const auto& record : fire_records_) {
-                    if (record.longitude >= lo && record.longitude <= hi) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
                 }
@@ -307,7 +443,7 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
                 break;
             }
             case Column::RawValue: {
-            double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+            double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
                 for (const auto& record : fire_records_) {
                     if (!std::isnan(record.raw_value) && record.raw_value >= lo && record.raw_value <= hi) {
                         results.push_back(fire_to_view(record));
@@ -362,8 +498,9 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
             }
             case Column::SiteId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return (long long)s.name_id >= lo && (long long)s.name_id <= hi; });
                 for (const auto& record : fire_records_) {
-                    if ((long long)record.site_id >= lo && (long long)record.site_id <= hi) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
                 }
@@ -371,8 +508,9 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
             }
             case Column::AgencyId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return (long long)s.agency_id >= lo && (long long)s.agency_id <= hi; });
                 for (const auto& record : fire_records_) {
-                    if ((long long)record.agency_id >= lo && (long long)record.agency_id <= hi) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
                 }
@@ -380,8 +518,39 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
             }
             case Column::AqsId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return (long long)s.aqs_id >= lo && (long long)s.aqs_id <= hi; });
                 for (const auto& record : fire_records_) {
-                    if ((long long)record.aqs_id >= lo && (long long)record.aqs_id <= hi) {
+                    if (match[record.site_id]) {
+                        results.push_back(fire_to_view(record));
+                    }
+                }
+                break;
+            }
+            case Column::ParameterName:
+            case Column::UnitName: {
+                // Name-ordered dictionaries: the name range is an id range
+                const bool param = col == Column::ParameterName;
+                const auto range = (param ? dictionaries_.frozen.parameter : dictionaries_.frozen.unit).idRange(loS, hiS);
+                for (const auto& record : fire_records_) {
+                    const uint32_t id = param ? record.parameter_id : record.unit_id;
+                    if (id >= range.first && id < range.second) {
+                        results.push_back(fire_to_view(record));
+                    }
+                }
+                break;
+            }
+            case Column::SiteName:
+            case Column::AgencyName:
+            case Column::AqsName: {
+                const FrozenDictionary& names = col == Column::SiteName ? dictionaries_.frozen.site
+                    : col == Column::AgencyName ? dictionaries_.frozen.agency : dictionaries_.frozen.aqs;
+                const auto range = names.idRange(loS, hiS);
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) {
+                    const uint32_t id = col == Column::SiteName ? s.name_id : col == Column::AgencyName ? s.agency_id : s.aqs_id;
+                    return id >= range.first && id < range.second;
+                });
+                for (const auto& record : fire_records_) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
                 }
@@ -394,7 +563,7 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
         // WorldBank-specific queries
         switch (col) {
         case Column::Population: {
-            double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+            double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
                 for (const auto& record : worldbank_records_) {
                     if (record.population >= lo && record.population <= hi) {
                         results.push_back(worldbank_to_view(record));
@@ -429,6 +598,18 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
                 }
                 break;
             }
+            case Column::WB_CountryName:
+            case Column::WB_CountryCode: {
+                const bool name = col == Column::WB_CountryName;
+                const auto range = (name ? dictionaries_.frozen.country_name : dictionaries_.frozen.country_code).idRange(loS, hiS);
+                for (const auto& record : worldbank_records_) {
+                    const uint32_t id = name ? record.country_name_id : record.country_code_id;
+                    if (id >= range.first && id < range.second) {
+                        results.push_back(worldbank_to_view(record));
+                    }
+                }
+                break;
+            }
             default:
                 return {}; // Unsupported column for WorldBank dataset
         }
@@ -441,6 +622,7 @@ RecordViews MapDataSource::findByRange(Column col, const std::string& loS, const
 std::optional<RecordView> MapDataSource::findMin() {
     if (dataset_ == Dataset::Fire) {
         if (fire_records_.empty()) return std::nullopt;
+        if (value_index_) return fire_to_view(**value_index_->first());
         auto it = std::min_element(fire_records_.begin(), fire_records_.end(),
             [](const FireRecord& a, const FireRecord& b) { return a.numericValue < b.numericValue; });
         return fire_to_view(*it);
@@ -455,6 +637,7 @@ std::optional<RecordView> MapDataSource::findMin() {
 std::optional<RecordView> MapDataSource::findMax() {
     if (dataset_ == Dataset::Fire) {
         if (fire_records_.empty()) return std::nullopt;
+        if (value_index_) return fire_to_view(**value_index_->last());
         auto it = std::max_element(fire_records_.begin(), fire_records_.end(),
             [](const FireRecord& a, const FireRecord& b) { return a.numericValue < b.numericValue; });
         return fire_to_view(*it);
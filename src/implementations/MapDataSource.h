@@ -1,13 +1,18 @@
 #pragma once
 #include "../interfaces/IDataSource.h"
+#include "../interfaces/LoadOptions.h"
+#include "../utility/LoadPlanner.h"
+#include "../utility/Metrics.h"
 #include "../utility/Records.h"
+#include "../index/ConcurrentSkipList.h"
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 class MapDataSource : public IDataSource {
 public:
-    explicit MapDataSource(const std::string& filePath);
+    explicit MapDataSource(const std::string& filePath, const LoadOptions& options = {});
 
     // Column-aware API (all scans)
     RecordViews findByRange(Column col, const std::string& minVal, const std::string& maxVal) override;
@@ -17,15 +22,25 @@ public:
     std::optional<RecordView> findMax() override;
     double sumByYear(int year) override;
 
+    // Read-only access for micro-benchmarks
+    const std::list<FireRecord>& fireRecords() const { return fire_records_; }
+
 private:
     enum class Dataset { Fire, WorldBank };
     Dataset dataset_{Dataset::WorldBank};
+    LoadOptions options_;
 
     // AoS: Array of Structures (using lean records)
     std::list<FireRecord> fire_records_;
     std::list<WorldBankRecord> worldbank_records_;
     Dictionaries dictionaries_;
 
+    // Optional ordered index on numericValue (Fire): (value, row) -> record.
+    // List nodes never move, so record pointers stay valid.
+    using ValueIndex = ConcurrentSkipList<RowKey<double>, const FireRecord*>;
+    std::unique_ptr<ValueIndex> value_index_;
+    void build_value_index();
+
     // Helper functions
     static bool to_ll(const std::string& s, long long& out);
     static bool to_int(const std::string& s, int& out);
@@ -34,13 +49,23 @@ private:
     // Loading functions
     void load_fire_data(const std::string& filePath);
     void load_worldbank_data(const std::string& filePath);
+    void load_directory(const std::vector<LoadTask>& files);
+    void finalize_dictionaries();
+
+    // Parse one task, appending to out; returns rows appended.
+    size_t parse_fire_file(const LoadTask& task, std::list<FireRecord>& out, Dictionaries& dicts);
+    size_t parse_worldbank_file(const LoadTask& task, std::list<WorldBankRecord>& out, Dictionaries& dicts);
     
     // Conversion functions
     RecordView fire_to_view(const FireRecord& record) const;
     RecordView worldbank_to_view(const WorldBankRecord& record) const;
     
-    // Dictionary helpers
-    uint32_t dict_get_or_add(std::unordered_map<std::string, uint32_t>& dict, const std::string& key);
-    uint16_t dict_get_or_add(std::unordered_map<std::string, uint16_t>& dict, const std::string& key);
+    // Fire helpers
     long long parse_utc_minutes(const std::string& utc);
+
+    // Metrics: per-file ingest counters and post-load gauges
+    // newestUtc: newest utc_minutes of the task's rows (Fire), for live ingest lag
+    void record_file_ingested(size_t rows, size_t files, int32_t newestUtc = INT32_MIN) const;
+    void publish_load_metrics() const;
+    mutable IngestLag ingest_lag_;
 };
@@ -0,0 +1,751 @@
+#include "RawDataSource.h"
+#include "VectorDataSource.h"
+#include "../utility/BatchEncoder.h"
+#include "../utility/CSVParser.h"
+#include "../utility/LoadPlanner.h"
+#include "../utility/Metrics.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// -------- small utils --------
+static inline bool isPopulationHeader(const std::vector<std::string>& hdr) {
+    return !hdr.empty() && hdr[0] == "Country Name";
+}
+
+static inline bool looksLikeFireRow(const std::vector<std::string>& row) {
+    if (row.size() < 12) return false;
+    auto isnum = [](const std::string& s){
+        if (s.empty()) return false;
+        char* end=nullptr; std::strtod(s.c_str(), &end); return end && *end=='\0';
+    };
+    if (!isnum(row[0]) || !isnum(row[1])) return false;
+    const std::string& t = row[2];
+    auto isdig = [](char ch){ return ch >= '0' && ch <= '9'; };
+    return t.size()>=16 && isdig(t[0]) && isdig(t[1]) && isdig(t[2]) && isdig(t[3]) && t[4]=='-' && t[7]=='-' && (t[10]=='T' || t[10]==' ') && t[13]==':';
+}
+
+// -------- field access over mapped bytes --------
+// Start of the field after the one at p; quotes are tracked the way
+// CSVParser tracks them, so a separator inside quotes does not count.
+static inline const char* skip_field(const char* p, const char* end) {
+    while (p < end) {
+        if (*p == '"') {
+            const void* q = std::memchr(p + 1, '"', (size_t)(end - p - 1));
+            p = q ? static_cast<const char*>(q) + 1 : end;
+        } else if (*p++ == ',') {
+            return p;
+        }
+    }
+    return end;
+}
+
+// The field at p as CSVParser::splitLine yields it: quotes removed, ""
+// unescaped, trailing blanks of unquoted fields trimmed. Points into the
+// file unless the field has escapes, then into scratch.
+static std::string_view field_text(const char* p, const char* end, std::string& scratch) {
+    if (p < end && *p == '"') {
+        const char* s = ++p;
+        while (p < end && *p != '"') ++p;
+        if (p + 1 >= end || p[1] != '"') return std::string_view(s, (size_t)(p - s));
+        scratch.assign(s, (size_t)(p - s));
+        while (p < end) {
+            if (*p == '"') {
+                if (p + 1 < end && p[1] == '"') { scratch.push_back('"'); p += 2; continue; }
+                break;
+            }
+            scratch.push_back(*p++);
+        }
+        return scratch;
+    }
+    const char* s = p;
+    while (p < end && *p != ',' && *p != '\n' && *p != '\r') ++p;
+    while (p > s && (p[-1] == ' ' || p[-1] == '\t')) --p;
+    return std::string_view(s, (size_t)(p - s));
+}
+
+// std::stod / std::stoi without the allocation: leading blanks and
+// trailing junk allowed, no digits or out of range fails. Plain decimals
+// of up to 15 digits take Clinger's fast path: the digits and the power of
+// ten are exact doubles, so one division rounds exactly as strtod does.
+static bool parse_double(std::string_view s, double& out) {
+    static constexpr double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    const char* p = s.data();
+    const char* e = p + s.size();
+    const bool negative = p < e && *p == '-';
+    if (p < e && (*p == '-' || *p == '+')) ++p;
+    uint64_t mantissa = 0;
+    int digits = 0, fraction = 0;
+    for (; p < e && *p >= '0' && *p <= '9'; ++p, ++digits) mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+    if (p < e && *p == '.') {
+        for (++p; p < e && *p >= '0' && *p <= '9'; ++p, ++digits, ++fraction) mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+    }
+    if (p == e && digits > 0 && digits <= 15) {
+        const double v = (double)mantissa / kPow10[fraction];
+        out = negative ? -v : v;
+        return true;
+    }
+
+    char buf[64];
+    if (s.empty() || s.size() >= sizeof(buf)) return !s.empty() && VectorDataSource::to_double(std::string(s), out);
+    std::memcpy(buf, s.data(), s.size());
+    buf[s.size()] = '\0';
+    char* end = nullptr;
+    errno = 0;
+    const double v = std::strtod(buf, &end);
+    if (end == buf || errno == ERANGE) return false;
+    out = v;
+    return true;
+}
+
+static bool parse_int(std::string_view s, int& out) {
+    // Plain short integers directly
+    if (!s.empty() && s.size() <= 9) {
+        size_t i = s[0] == '-' || s[0] == '+' ? 1 : 0;
+        int v = 0;
+        const size_t first = i;
+        for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) v = v * 10 + (s[i] - '0');
+        if (i == s.size() && i > first) {
+            out = s[0] == '-' ? -v : v;
+            return true;
+        }
+    }
+
+    char buf[32];
+    if (s.empty() || s.size() >= sizeof(buf)) return !s.empty() && VectorDataSource::to_int(std::string(s), out);
+    std::memcpy(buf, s.data(), s.size());
+    buf[s.size()] = '\0';
+    char* end = nullptr;
+    errno = 0;
+    const long v = std::strtol(buf, &end, 10);
+    if (end == buf || errno == ERANGE || v < INT_MIN || v > INT_MAX) return false;
+    out = (int)v;
+    return true;
+}
+
+// std::atoi over s[0, n)
+static int atoi_n(const char* s, size_t n) {
+    size_t i = 0;
+    while (i < n && std::isspace((unsigned char)s[i])) ++i;
+    bool negative = false;
+    if (i < n && (s[i] == '+' || s[i] == '-')) negative = s[i++] == '-';
+    int v = 0;
+    for (; i < n && s[i] >= '0' && s[i] <= '9'; ++i) v = v * 10 + (s[i] - '0');
+    return negative ? -v : v;
+}
+
+// Same result as the loaders' parse_utc_minutes
+static long long utc_minutes_of(std::string_view utc) {
+    if (utc.size() < 16) return 0;
+    std::tm tm{};
+    tm.tm_year = atoi_n(utc.data(), 4) - 1900;
+    tm.tm_mon  = atoi_n(utc.data() + 5, 2) - 1;
+    tm.tm_mday = atoi_n(utc.data() + 8, 2);
+    tm.tm_hour = atoi_n(utc.data() + 11, 2);
+    tm.tm_min  = atoi_n(utc.data() + 14, 2);
+    #ifdef _WIN32
+    time_t t = _mkgmtime(&tm);
+    #else
+    time_t t = timegm(&tm);
+    #endif
+    return (long long)t / 60;
+}
+
+// -------- construction --------
+RawDataSource::RawDataSource(const std::string& filePath, const LoadOptions& options)
+    : options_(options)
+{
+    namespace fs = std::filesystem;
+
+    // Sniff the dataset the way the loaders do
+    std::vector<LoadTask> files;
+    bool worldBank = false;
+    std::error_code ec;
+    if (fs::is_directory(fs::status(filePath, ec)) && !ec) {
+        files = LoadPlanner::discover(filePath);
+        if (files.empty()) return;
+        std::string firstLine;
+        CSVParser::countLines(files.front().path, 0, 64 * 1024, &firstLine);
+        std::vector<std::string> first;
+        CSVParser::splitLine(firstLine, first);
+        worldBank = isPopulationHeader(first) || !looksLikeFireRow(first);
+    } else {
+        LoadTask task;
+        task.path = filePath;
+        task.end = (uint64_t)fs::file_size(filePath, ec);
+        if (ec) return;
+        files.push_back(task);
+        CSVParser csv(filePath, /*hasHeader=*/true);
+        std::vector<std::string> header;
+        worldBank = csv.readHeader(header) && isPopulationHeader(header);
+    }
+    if (worldBank) {
+        loaded_ = std::make_unique<VectorDataSource>(filePath, options_);
+        return;
+    }
+
+    // Row starts are 32-bit offsets within a segment
+    const uint64_t kMaxSegment = uint64_t(1) << 31;
+    const uint64_t chunk = options_.chunkBytes && options_.chunkBytes < kMaxSegment ? options_.chunkBytes : kMaxSegment;
+    for (const LoadTask& task : LoadPlanner::splitOversized(files, chunk)) {
+        if (task.firstChunk) files_.push_back(std::make_unique<MappedFile>(task.path));
+        const MappedFile& file = *files_.back();
+        Segment seg;
+        if (task.begin < file.size()) {
+            seg.begin = file.data() + task.begin;
+            seg.fileEnd = file.data() + file.size();
+            seg.bytes = (size_t)(std::min<uint64_t>(task.end, file.size()) - task.begin);
+            if (task.begin == 0 && seg.bytes >= 3 && std::memcmp(seg.begin, "\xEF\xBB\xBF", 3) == 0) {
+                seg.begin += 3;
+                seg.bytes -= 3;
+            }
+        }
+        segments_.push_back(seg);
+    }
+}
+
+RawDataSource::~RawDataSource() = default;
+
+// -------- positional map --------
+// One pass over the bytes: a row is kept when the loaders would keep it (at
+// least 12 fields, numeric latitude and longitude). Every field is
+// tokenized here anyway, so a few of their offsets seed the map, and the
+// coordinates become the first cached columns.
+void RawDataSource::find_rows() {
+    rows_found_ = true;
+    static constexpr Field kAnchors[] = {Parameter, RawValue, SiteName};
+    struct Found {
+        std::vector<uint32_t> start;
+        std::vector<float> latitude, longitude;
+        std::vector<uint16_t> anchor[3];
+    };
+    const long long n = (long long)segments_.size();
+    std::vector<Found> found(segments_.size());
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long s = 0; s < n; ++s) {
+        const Segment& seg = segments_[s];
+        Found& out = found[s];
+        std::string scratch;
+        const char* p = seg.begin;
+        const char* stop = seg.begin + seg.bytes;
+        const char* end = seg.fileEnd;
+        while (p < stop) {
+            const char* row = p;
+            const char* at[kFields] = {row};
+            int field = 0;
+            while (p < end && *p != '\n') {
+                if (*p == '"') {
+                    // Jump to the closing quote ("" reopens on the next pass)
+                    for (++p; p < end && *p != '"'; ++p) {}
+                    if (p < end) ++p;
+                } else if (*p++ == ',' && ++field < kFields) {
+                    at[field] = p;
+                }
+            }
+            if (p < end) ++p;
+
+            double lat, lon;
+            if (field + 1 < kFields) continue;
+            if (!parse_double(field_text(at[Latitude], end, scratch), lat)) continue;
+            if (!parse_double(field_text(at[Longitude], end, scratch), lon)) continue;
+            out.start.push_back((uint32_t)(row - seg.begin));
+            out.latitude.push_back((float)lat);
+            out.longitude.push_back((float)lon);
+            for (size_t a = 0; a < 3; ++a) {
+                const ptrdiff_t offset = at[kAnchors[a]] - row;
+                out.anchor[a].push_back(offset < kNoPosition ? (uint16_t)offset : kNoPosition);
+            }
+        }
+    }
+
+    for (size_t s = 0; s < segments_.size(); ++s) {
+        segments_[s].firstRow = rows_;
+        segments_[s].rows = found[s].start.size();
+        rows_ += found[s].start.size();
+    }
+    row_start_.resize(rows_);
+    latitude_.resize(rows_);
+    longitude_.resize(rows_);
+    for (Field f : kAnchors) positions_[f].resize(rows_);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long s = 0; s < n; ++s) {
+        const size_t first = segments_[s].firstRow;
+        std::copy(found[s].start.begin(), found[s].start.end(), row_start_.begin() + first);
+        std::copy(found[s].latitude.begin(), found[s].latitude.end(), latitude_.begin() + first);
+        std::copy(found[s].longitude.begin(), found[s].longitude.end(), longitude_.begin() + first);
+        for (size_t a = 0; a < 3; ++a) {
+            std::copy(found[s].anchor[a].begin(), found[s].anchor[a].end(), positions_[kAnchors[a]].begin() + first);
+        }
+        found[s] = Found();
+    }
+    cached_[Latitude] = cached_[Longitude] = true;
+    last_use_[Latitude] = last_use_[Longitude] = clock_;
+
+    static Counter& filesIngested = MetricsRegistry::instance().counter(
+        "mini1_files_ingested_total", "CSV files ingested", "impl=\"raw\"");
+    static Counter& rowsIngested = MetricsRegistry::instance().counter(
+        "mini1_rows_ingested_total", "Records ingested", "impl=\"raw\"");
+    filesIngested.inc(files_.size());
+    rowsIngested.inc(rows_);
+}
+
+// fn(segment, row, start of the field, file end, scratch) for every row, in
+// row order within a segment, segments in parallel. Starts from the nearest
+// field at or before `field` whose offset is known, and records the field's
+// offsets the first time.
+template <typename Fn>
+void RawDataSource::for_each_field(Field field, Fn fn) {
+    int anchor = field;
+    while (anchor > 0 && positions_[anchor].empty()) --anchor;
+    const bool record = anchor != field;
+    if (record) positions_[field].resize(rows_);
+
+    const long long n = (long long)segments_.size();
+    #pragma omp parallel
+    {
+        std::string scratch;
+        #pragma omp for schedule(dynamic, 1)
+        for (long long s = 0; s < n; ++s) {
+            const Segment& seg = segments_[s];
+            for (size_t r = seg.firstRow; r < seg.firstRow + seg.rows; ++r) {
+                const char* row = seg.begin + row_start_[r];
+                const char* p = row;
+                int at = 0;
+                if (anchor > 0 && positions_[anchor][r] != kNoPosition) {
+                    p = row + positions_[anchor][r];
+                    at = anchor;
+                }
+                for (; at < field; ++at) p = skip_field(p, seg.fileEnd);
+                if (record) {
+                    const ptrdiff_t offset = p - row;
+                    positions_[field][r] = offset < kNoPosition ? (uint16_t)offset : kNoPosition;
+                }
+                fn((size_t)s, (uint32_t)r, p, seg.fileEnd, scratch);
+            }
+        }
+    }
+}
+
+size_t RawDataSource::positionalMapBytes() const {
+    size_t bytes = row_start_.capacity() * sizeof(uint32_t);
+    for (const auto& p : positions_) bytes += p.capacity() * sizeof(uint16_t);
+    return bytes;
+}
+
+// -------- column cache --------
+bool RawDataSource::is_dictionary(Field field) {
+    return field == Parameter || field == Unit || field == SiteName || field == Agency || field == Aqs;
+}
+
+size_t RawDataSource::column_bytes(Field field) const {
+    switch (field) {
+        case Latitude: return latitude_.capacity() * sizeof(float);
+        case Longitude: return longitude_.capacity() * sizeof(float);
+        case Utc: return utc_minutes_.capacity() * sizeof(int32_t) + year_.capacity() * sizeof(int16_t);
+        case Value: return value_.capacity() * sizeof(float);
+        case RawValue: return raw_value_.capacity() * sizeof(float);
+        case Aqi: return aqi_.capacity() * sizeof(int16_t);
+        case Category: return category_.capacity();
+        default: return ids_[field].capacity() * sizeof(uint32_t);
+    }
+}
+
+size_t RawDataSource::cachedBytes() const {
+    size_t bytes = 0;
+    for (int f = 0; f < kFields; ++f) bytes += column_bytes((Field)f);
+    return bytes;
+}
+
+void RawDataSource::drop_column(Field field) {
+    switch (field) {
+        case Latitude: std::vector<float>().swap(latitude_); break;
+        case Longitude: std::vector<float>().swap(longitude_); break;
+        case Utc: std::vector<int32_t>().swap(utc_minutes_); std::vector<int16_t>().swap(year_); break;
+        case Value: std::vector<float>().swap(value_); break;
+        case RawValue: std::vector<float>().swap(raw_value_); break;
+        case Aqi: std::vector<int16_t>().swap(aqi_); break;
+        case Category: std::vector<uint8_t>().swap(category_); break;
+        default: std::vector<uint32_t>().swap(ids_[field]); break;
+    }
+    cached_[field] = false;
+}
+
+void RawDataSource::need(Field field) {
+    static Counter& cached = MetricsRegistry::instance().counter(
+        "mini1_raw_columns_total", "Columns read by raw-source queries", "impl=\"raw\",outcome=\"cached\"");
+    static Counter& parsed = MetricsRegistry::instance().counter(
+        "mini1_raw_columns_total", "Columns read by raw-source queries", "impl=\"raw\",outcome=\"parsed\"");
+    last_use_[field] = clock_;
+    if (cached_[field]) { cached.inc(); return; }
+    parsed.inc();
+    parse_column(field);
+    cached_[field] = true;
+}
+
+void RawDataSource::parse_column(Field field) {
+    if (is_dictionary(field)) { parse_dictionary(field); return; }
+    // Same values and missing-value rules as the loaders
+    switch (field) {
+        case Latitude:
+        case Longitude: {
+            std::vector<float>& out = field == Latitude ? latitude_ : longitude_;
+            out.resize(rows_);
+            for_each_field(field, [&](size_t, uint32_t row, const char* p, const char* end, std::string& scratch) {
+                double v = 0;
+                parse_double(field_text(p, end, scratch), v);
+                out[row] = (float)v;
+            });
+            break;
+        }
+        case Utc: {
+            utc_minutes_.resize(rows_);
+            year_.resize(rows_);
+            for_each_field(field, [&](size_t, uint32_t row, const char* p, const char* end, std::string& scratch) {
+                // Rows of a file share a few timestamps; convert each run once
+                thread_local std::string last;
+                thread_local int32_t minutes = 0;
+                const std::string_view utc = field_text(p, end, scratch);
+                if (utc != last) {
+                    last.assign(utc.data(), utc.size());
+                    minutes = (int32_t)utc_minutes_of(utc);
+                }
+                int yr = 0;
+                if (utc.size() >= 4) { int v = 0; if (parse_int(utc.substr(0, 4), v)) yr = v; }
+                utc_minutes_[row] = minutes;
+                year_[row] = (int16_t)yr;
+            });
+            break;
+        }
+        case Value:
+        case RawValue: {
+            std::vector<float>& out = field == Value ? value_ : raw_value_;
+            out.resize(rows_);
+            for_each_field(field, [&](size_t, uint32_t row, const char* p, const char* end, std::string& scratch) {
+                double v;
+                float f = std::numeric_limits<float>::quiet_NaN();
+                if (parse_double(field_text(p, end, scratch), v) && v != -999.0) f = (float)v;
+                out[row] = f;
+            });
+            break;
+        }
+        case Aqi: {
+            aqi_.resize(rows_);
+            for_each_field(field, [&](size_t, uint32_t row, const char* p, const char* end, std::string& scratch) {
+                int v = -999;
+                parse_int(field_text(p, end, scratch), v);
+                aqi_[row] = (int16_t)v;
+            });
+            break;
+        }
+        case Category: {
+            category_.resize(rows_);
+            for_each_field(field, [&](size_t, uint32_t row, const char* p, const char* end, std::string& scratch) {
+                int v = 0;
+                parse_int(field_text(p, end, scratch), v);
+                category_[row] = (uint8_t)v;
+            });
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Name-ordered ids, as after a load. The first parse encodes each segment
+// against its own first-seen names (batched get-or-add over the mapped
+// text), then sorts the distinct names once and remaps. The dictionary
+// outlives the ids, so a re-parse only looks names up.
+void RawDataSource::parse_dictionary(Field field) {
+    std::vector<uint32_t>& ids = ids_[field];
+    ids.resize(rows_);
+    FrozenDictionary& dict = dicts_[field];
+    if (dict.size()) {
+        for_each_field(field, [&](size_t, uint32_t row, const char* p, const char* end, std::string& scratch) {
+            ids[row] = dict.find(field_text(p, end, scratch));
+        });
+        return;
+    }
+
+    // Runs of one name (a site's rows are adjacent) are encoded once: ids
+    // hold the run first, then its segment-local, global and final id
+    const long long n = (long long)segments_.size();
+    std::vector<std::vector<std::string_view>> runs(segments_.size());
+    std::vector<std::deque<std::string>> escaped(segments_.size());
+    for_each_field(field, [&](size_t s, uint32_t row, const char* p, const char* end, std::string& scratch) {
+        std::string_view text = field_text(p, end, scratch);
+        if (runs[s].empty() || text != runs[s].back()) {
+            if (!text.empty() && text.data() == scratch.data()) {
+                escaped[s].push_back(scratch);
+                text = escaped[s].back();
+            }
+            runs[s].push_back(text);
+        }
+        ids[row] = (uint32_t)runs[s].size() - 1;
+    });
+
+    std::vector<std::vector<std::string_view>> names(segments_.size());
+    std::vector<std::vector<uint32_t>> runIds(segments_.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long s = 0; s < n; ++s) {
+        BatchEncoder<std::string_view> encoder(names[s]);
+        std::vector<const std::string_view*> keys(runs[s].size());
+        for (size_t i = 0; i < keys.size(); ++i) keys[i] = &runs[s][i];
+        runIds[s].resize(keys.size());
+        encoder.encode(keys.data(), keys.size(), runIds[s].data());
+    }
+
+    // Segment names -> first-seen global ids -> rank in byte order
+    std::vector<std::string_view> global;
+    std::vector<std::vector<uint32_t>> globalIds(segments_.size());
+    {
+        BatchEncoder<std::string_view> encoder(global);
+        std::vector<const std::string_view*> keys;
+        for (size_t s = 0; s < segments_.size(); ++s) {
+            keys.resize(names[s].size());
+            for (size_t i = 0; i < keys.size(); ++i) keys[i] = &names[s][i];
+            globalIds[s].resize(keys.size());
+            encoder.encode(keys.data(), keys.size(), globalIds[s].data());
+        }
+    }
+    std::vector<uint32_t> order(global.size()), rank(global.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return global[a] < global[b]; });
+    std::vector<std::string> sorted(global.size());
+    for (uint32_t i = 0; i < (uint32_t)order.size(); ++i) {
+        rank[order[i]] = i;
+        sorted[i] = std::string(global[order[i]]);
+    }
+    dict = FrozenDictionary(sorted);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long s = 0; s < n; ++s) {
+        for (uint32_t& id : runIds[s]) id = rank[globalIds[s][id]];
+        const Segment& seg = segments_[s];
+        for (size_t r = seg.firstRow; r < seg.firstRow + seg.rows; ++r) ids[r] = runIds[s][ids[r]];
+    }
+}
+
+// -------- query bookkeeping --------
+void RawDataSource::begin_query() {
+    ++clock_;
+    if (!rows_found_) find_rows();
+}
+
+// Over the cap, drop the least recently used columns this query did not read
+void RawDataSource::end_query() {
+    if (options_.rawCacheBytes) {
+        size_t bytes = cachedBytes();
+        while (bytes > options_.rawCacheBytes) {
+            int victim = -1;
+            for (int f = 0; f < kFields; ++f) {
+                if (cached_[f] && last_use_[f] < clock_ && (victim < 0 || last_use_[f] < last_use_[victim])) victim = f;
+            }
+            if (victim < 0) break;
+            bytes -= column_bytes((Field)victim);
+            drop_column((Field)victim);
+        }
+    }
+    publish_metrics();
+}
+
+void RawDataSource::publish_metrics() const {
+    auto& reg = MetricsRegistry::instance();
+    const std::string impl = "impl=\"raw\"";
+    reg.gauge("mini1_records", "Records held", impl).set((double)rows_);
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"positional_map\"")
+        .set((double)positionalMapBytes());
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"column_cache\"")
+        .set((double)cachedBytes());
+    size_t dictBytes = 0;
+    for (const auto& d : dicts_) dictBytes += d.memoryBytes();
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"dictionaries\"")
+        .set((double)dictBytes);
+}
+
+// -------- conversion helpers --------
+double RawDataSource::numeric_value(uint32_t row) const {
+    return std::isnan(value_[row]) ? 0.0 : value_[row];
+}
+
+RecordView RawDataSource::to_view(uint32_t row) const {
+    RecordView view;
+    view.type = RecordView::Type::Fire;
+    view.year = year_[row];
+    view.numericValue = numeric_value(row);
+    view.latitude = latitude_[row];
+    view.longitude = longitude_[row];
+    view.value = value_[row];
+    view.aqi = aqi_[row];
+    view.parameter_id = (uint16_t)ids_[Parameter][row];
+    view.unit_id = (uint16_t)ids_[Unit][row];
+    view.site_id = ids_[SiteName][row];
+    view.agency_id = ids_[Agency][row];
+    view.aqs_id = ids_[Aqs][row];
+    return view;
+}
+
+// Results carry the view's columns, so any row out parses them; in field
+// order, so each parse starts from the previous one's offsets
+RecordViews RawDataSource::to_views(const std::vector<uint32_t>& rows) {
+    if (rows.empty()) return {};
+    for (Field f : {Latitude, Longitude, Utc, Parameter, Value, Unit, Aqi, SiteName, Agency, Aqs}) need(f);
+    RecordViews views;
+    views.reserve(rows.size());
+    for (uint32_t row : rows) views.push_back(to_view(row));
+    return views;
+}
+
+// -------- column-aware API --------
+RecordViews RawDataSource::findByRange(Column col, const std::string& loS, const std::string& hiS) {
+    if (loaded_) return loaded_->findByRange(col, loS, hiS);
+
+    begin_query();
+    std::vector<uint32_t> rows;
+    auto filter = [&](auto pred) {
+        for (uint32_t r = 0; r < (uint32_t)rows_; ++r) {
+            if (pred(r)) rows.push_back(r);
+        }
+    };
+    auto select = [&](Field field, auto pred) {
+        need(field);
+        filter(pred);
+    };
+    // Bad arguments still end the query, so the cache cap and metrics apply
+    bool valid = true;
+
+    switch (col) {
+        case Column::Value: {
+            double lo=0, hi=0; if(!VectorDataSource::to_double(loS,lo)||!VectorDataSource::to_double(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            select(Value, [&](uint32_t r) { const double v = numeric_value(r); return v >= lo && v <= hi; });
+            break;
+        }
+        case Column::Latitude:
+        case Column::Longitude: {
+            double lo=0, hi=0; if(!VectorDataSource::to_double(loS,lo)||!VectorDataSource::to_double(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            const bool lat = col == Column::Latitude;
+            select(lat ? Latitude : Longitude, [&](uint32_t r) {
+                const float v = lat ? latitude_[r] : longitude_[r];
+                return v >= lo && v <= hi;
+            });
+            break;
+        }
+        case Column::Year: {
+            int lo=0, hi=0; if(!VectorDataSource::to_int(loS,lo)||!VectorDataSource::to_int(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            select(Utc, [&](uint32_t r) { return year_[r] >= lo && year_[r] <= hi; });
+            break;
+        }
+        case Column::RawValue: {
+            double lo=0, hi=0; if(!VectorDataSource::to_double(loS,lo)||!VectorDataSource::to_double(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            select(RawValue, [&](uint32_t r) {
+                return !std::isnan(raw_value_[r]) && raw_value_[r] >= lo && raw_value_[r] <= hi;
+            });
+            break;
+        }
+        case Column::AQI: {
+            int lo=0, hi=0; if(!VectorDataSource::to_int(loS,lo)||!VectorDataSource::to_int(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            select(Aqi, [&](uint32_t r) { return aqi_[r] >= lo && aqi_[r] <= hi; });
+            break;
+        }
+        case Column::Category: {
+            int lo=0, hi=0; if(!VectorDataSource::to_int(loS,lo)||!VectorDataSource::to_int(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            select(Category, [&](uint32_t r) { return (int)category_[r] >= lo && (int)category_[r] <= hi; });
+            break;
+        }
+        case Column::UTCMinutes: {
+            long long lo=0, hi=0; if(!VectorDataSource::to_ll(loS,lo)||!VectorDataSource::to_ll(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            select(Utc, [&](uint32_t r) { return utc_minutes_[r] >= lo && utc_minutes_[r] <= hi; });
+            break;
+        }
+        case Column::ParameterId:
+        case Column::UnitId:
+        case Column::SiteId:
+        case Column::AgencyId:
+        case Column::AqsId: {
+            long long lo=0, hi=0; if(!VectorDataSource::to_ll(loS,lo)||!VectorDataSource::to_ll(hiS,hi)||!(lo<=hi)) { valid = false; break; }
+            const Field field = col == Column::ParameterId ? Parameter : col == Column::UnitId ? Unit
+                : col == Column::SiteId ? SiteName : col == Column::AgencyId ? Agency : Aqs;
+            select(field, [&](uint32_t r) { return (long long)ids_[field][r] >= lo && (long long)ids_[field][r] <= hi; });
+            break;
+        }
+        case Column::ParameterName:
+        case Column::UnitName:
+        case Column::SiteName:
+        case Column::AgencyName:
+        case Column::AqsName: {
+            // Name-ordered dictionaries: the name range is an id range
+            const Field field = col == Column::ParameterName ? Parameter : col == Column::UnitName ? Unit
+                : col == Column::SiteName ? SiteName : col == Column::AgencyName ? Agency : Aqs;
+            need(field);
+            const auto range = dicts_[field].idRange(loS, hiS);
+            filter([&](uint32_t r) { return ids_[field][r] >= range.first && ids_[field][r] < range.second; });
+            break;
+        }
+        default:
+            valid = false; // Unsupported column for Fire dataset
+            break;
+    }
+
+    RecordViews results = valid ? to_views(rows) : RecordViews{};
+    end_query();
+    return results;
+}
+
+// -------- extremes & aggregate over unified numericValue --------
+std::optional<RecordView> RawDataSource::findMin() {
+    if (loaded_) return loaded_->findMin();
+    begin_query();
+    if (rows_ == 0) { end_query(); return std::nullopt; }
+    need(Value);
+    uint32_t best = 0;
+    for (uint32_t r = 1; r < (uint32_t)rows_; ++r) {
+        if (numeric_value(r) < numeric_value(best)) best = r;
+    }
+    RecordViews view = to_views({best});
+    end_query();
+    return view.front();
+}
+
+std::optional<RecordView> RawDataSource::findMax() {
+    if (loaded_) return loaded_->findMax();
+    begin_query();
+    if (rows_ == 0) { end_query(); return std::nullopt; }
+    need(Value);
+    uint32_t best = 0;
+    for (uint32_t r = 1; r < (uint32_t)rows_; ++r) {
+        if (numeric_value(best) < numeric_value(r)) best = r;
+    }
+    RecordViews view = to_views({best});
+    end_query();
+    return view.front();
+}
+
+double RawDataSource::sumByYear(int year) {
+    if (loaded_) return loaded_->sumByYear(year);
+    begin_query();
+    need(Utc);
+    need(Value);
+    double sum = 0.0;
+    for (uint32_t r = 0; r < (uint32_t)rows_; ++r) {
+        if (year_[r] == year) sum += numeric_value(r);
+    }
+    end_query();
+    return sum;
+}
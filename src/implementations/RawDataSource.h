@@ -0,0 +1,92 @@
+#pragma once
+#include "../interfaces/IDataSource.h"
+#include "../interfaces/LoadOptions.h"
+#include "../utility/FrozenDictionary.h"
+#include "../utility/MappedFile.h"
+#include "../utility/Records.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class VectorDataSource;
+
+// Queries straight over the mapped CSV files, without a load (NoDB style).
+// The first query finds the rows (their start offsets, checked like the
+// loaders check them); each column is parsed the first time a query needs
+// it and kept as a typed array, so repeated queries run over arrays like a
+// loaded source. A positional map of field offsets per row, seeded while
+// rows are found and extended by every column parse, lets a later parse
+// start at the nearest known field instead of the row start.
+// LoadOptions::rawCacheBytes caps the parsed columns; the least recently
+// used ones are dropped and re-parsed through the positional map.
+// AirNow data only; WorldBank files are small and go to a VectorDataSource.
+class RawDataSource : public IDataSource {
+public:
+    explicit RawDataSource(const std::string& filePath, const LoadOptions& options = {});
+    ~RawDataSource() override;
+
+    RecordViews findByRange(Column col, const std::string& minVal, const std::string& maxVal) override;
+    std::optional<RecordView> findMin() override;
+    std::optional<RecordView> findMax() override;
+    double sumByYear(int year) override;
+
+    // Rows found so far (0 before the first query)
+    size_t rows() const { return rows_; }
+    size_t positionalMapBytes() const;
+    size_t cachedBytes() const;
+
+private:
+    // AirNow fields, by position in a row
+    enum Field { Latitude, Longitude, Utc, Parameter, Value, Unit, RawValue, Aqi, Category, SiteName, Agency, Aqs, kFields };
+    static constexpr uint16_t kNoPosition = UINT16_MAX;   // offset too large for the map
+
+    // One load task: a file, or a line-aligned range of one
+    struct Segment {
+        const char* begin = nullptr;   // first byte of the range
+        const char* fileEnd = nullptr; // records may run past the range, not the file
+        size_t bytes = 0;
+        size_t firstRow = 0, rows = 0;
+    };
+
+    LoadOptions options_;
+    std::unique_ptr<VectorDataSource> loaded_;   // WorldBank
+    std::vector<std::unique_ptr<MappedFile>> files_;
+    std::vector<Segment> segments_;
+
+    // Positional map: row start (offset in its segment) and, per field, the
+    // field's offset from the row start; empty until some pass finds it
+    bool rows_found_ = false;
+    size_t rows_ = 0;
+    std::vector<uint32_t> row_start_;
+    std::vector<uint16_t> positions_[kFields];
+
+    // Column cache, by field; empty when not parsed (or dropped)
+    std::vector<float> latitude_, longitude_, value_, raw_value_;
+    std::vector<int32_t> utc_minutes_;
+    std::vector<int16_t> year_, aqi_;
+    std::vector<uint8_t> category_;
+    std::vector<uint32_t> ids_[kFields];          // dictionary fields
+    FrozenDictionary dicts_[kFields];            // name-ordered, kept when ids are dropped
+    bool cached_[kFields] = {};
+    uint64_t last_use_[kFields] = {};
+    uint64_t clock_ = 0;                          // one tick per query
+
+    void find_rows();
+    void begin_query();
+    void end_query();
+    void need(Field field);
+    void parse_column(Field field);
+    void parse_dictionary(Field field);
+    void drop_column(Field field);
+    size_t column_bytes(Field field) const;
+    static bool is_dictionary(Field field);
+
+    template <typename Fn>
+    void for_each_field(Field field, Fn fn);
+
+    RecordViews to_views(const std::vector<uint32_t>& rows);
+    RecordView to_view(uint32_t row) const;
+    double numeric_value(uint32_t row) const;
+
+    void publish_metrics() const;
+};
@@ -1,7 +1,13 @@
 #include "VectorDataSource.h"
+#include "../utility/BatchEncoder.h"
 #include "../utility/CSVParser.h"
+#include "../utility/Clustering.h"
+#include "../utility/LoadPlanner.h"
+#include "../utility/Metrics.h"
+#include "../utility/ParallelSort.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cctype>
 #include <cstdlib>
 #include <ctime>
@@ -41,7 +47,9 @@ bool VectorDataSource::to_int(const std::string& s, int& out){ if(s.empty()) ret
 bool VectorDataSource::to_double(const std::string& s, double& out){ if(s.empty()) return false; try{ out=std::stod(s); return true;}catch(...){return false;}}
 
 // -------- construction / load --------
-VectorDataSource::VectorDataSource(const std::string& filePath) {
+VectorDataSource::VectorDataSource(const std::string& filePath, const LoadOptions& options)
+    : options_(options), ingest_lag_("impl=\"vector\"")
+{
     namespace fs = std::filesystem;
 
     auto load_single = [&](const std::string& path) {
@@ -69,115 +77,28 @@ VectorDataSource::VectorDataSource(const std::string& filePath) {
     std::error_code ec;
     fs::file_status st = fs::status(filePath, ec);
     if (!ec && fs::is_directory(st)) {
-        // First pass: gather all CSV files and detect dataset type
-        std::vector<std::string> csvFiles;
-        bool datasetInitialized = false;
-        std::vector<std::string> firstHeader;
-        Dataset firstDataset = Dataset::WorldBank;
-
-        for (auto const& entry : fs::recursive_directory_iterator(filePath, ec)) {
-            if (ec) break;
-            if (!entry.is_regular_file()) continue;
-            const auto& p = entry.path();
-            if (p.extension() != ".csv") continue;
-            
-            csvFiles.push_back(p.string());
-
-            if (!datasetInitialized) {
-                CSVParser csv(p.string(), /*hasHeader=*/true);
-                bool hasHdr = csv.readHeader(firstHeader);
-                if (hasHdr && isPopulationHeader(firstHeader)) firstDataset = Dataset::WorldBank;
-                else {
-                    // peek first row to detect Fire vs WB
-                    std::vector<std::string> row;
-                    if (csv.next(row) && looksLikeFireRow(row)) firstDataset = Dataset::Fire;
-                    else firstDataset = Dataset::WorldBank;
-                }
-                dataset_ = firstDataset;
-                datasetInitialized = true;
-            }
-        }
-
-        // Second pass: parallel file loading with thread-local storage
-        if (dataset_ == Dataset::WorldBank) {
-            // Thread-local storage - no contention during processing
-            std::vector<WorldBankRecords> threadRecords(omp_get_max_threads());
-            std::vector<Dictionaries> threadDicts(omp_get_max_threads());
-            
-            #pragma omp parallel for schedule(dynamic, 1)
-            for (size_t i = 0; i < csvFiles.size(); ++i) {
-                int tid = omp_get_thread_num();
-                load_worldbank_data_thread_local(csvFiles[i], threadRecords[tid], threadDicts[tid]);
-            }
-            
-            // Merge thread-local results (minimal critical sections)
-            for (const auto& records : threadRecords) {
-                worldbank_records_.insert(worldbank_records_.end(), records.begin(), records.end());
-            }
-            merge_dictionaries(threadDicts);
-        } else if (dataset_ == Dataset::Fire) {
-            // Thread-local storage - no contention during processing
-            std::vector<FireRecords> threadRecords(omp_get_max_threads());
-            std::vector<Dictionaries> threadDicts(omp_get_max_threads());
-            
-            #pragma omp parallel for schedule(dynamic, 1)
-            for (size_t i = 0; i < csvFiles.size(); ++i) {
-                int tid = omp_get_thread_num();
-                load_fire_data_thread_local(csvFiles[i], threadRecords[tid], threadDicts[tid]);
-            }
-            
-            // Merge thread-local results (minimal critical sections)
-            for (const auto& records : threadRecords) {
-                fire_records_.insert(fire_records_.end(), records.begin(), records.end());
-            }
-            merge_dictionaries(threadDicts);
-        }
+        // Parallel discovery, then a two-phase parallel load into one array
+        load_directory(LoadPlanner::discover(filePath));
     } else {
         load_single(filePath);
     }
-}
-
-// ---- Fire helpers ----
-uint32_t VectorDataSource::dict_get_or_add(std::unordered_map<std::string, uint32_t>& dict, const std::string& key) {
-    auto it = dict.find(key);
-    if (it != dict.end()) return it->second;
-    uint32_t id = (uint32_t)dict.size();
-    dict.emplace(key, id);
-    
-    // Update reverse lookup vector
-    if (&dict == &dictionaries_.parameter_dict) {
-        dictionaries_.parameter_names.push_back(key);
-    } else if (&dict == &dictionaries_.unit_dict) {
-        dictionaries_.unit_names.push_back(key);
-    } else if (&dict == &dictionaries_.site_dict) {
-        dictionaries_.site_names.push_back(key);
-    } else if (&dict == &dictionaries_.agency_dict) {
-        dictionaries_.agency_names.push_back(key);
-    } else if (&dict == &dictionaries_.aqs_dict) {
-        dictionaries_.aqs_names.push_back(key);
-    } else if (&dict == &dictionaries_.country_name_dict) {
-        dictionaries_.country_names.push_back(key);
-    } else if (&dict == &dictionaries_.country_code_dict) {
-        dictionaries_.country_codes.push_back(key);
-    }
-    
-    return id;
-}
+    finalize_dictionaries();
 
-uint16_t VectorDataSource::dict_get_or_add(std::unordered_map<std::string, uint16_t>& dict, const std::string& key) {
-    auto it = dict.find(key);
-    if (it != dict.end()) return it->second;
-    uint16_t id = (uint16_t)dict.size();
-    dict.emplace(key, id);
-    
-    // Update reverse lookup vector
-    if (&dict == &dictionaries_.indicator_dict) {
-        dictionaries_.indicator_names.push_back(key);
+    if (dataset_ == Dataset::Fire) {
+        if (options_.clustering != LoadOptions::Clustering::None) reorganize();
+        zones_.build(fire_records_, dictionaries_.sites);
+        segment_bloom_.build(fire_records_, dictionaries_.sites);
+        build_ordered_indexes();
+        if (options_.pointIndex) pointIndex();
+        if (options_.heatmap) {
+            heatmap_ = std::make_unique<TilePyramid>();
+            heatmap_->build(fire_records_, dictionaries_.sites);
+        }
     }
-    
-    return id;
+    publish_load_metrics();
 }
 
+// ---- Fire helpers ----
 static inline int to_int2(const std::string& s) { return std::atoi(s.c_str()); }
 
 long long VectorDataSource::parse_utc_minutes(const std::string& utc) {
@@ -199,106 +120,549 @@ long long VectorDataSource::parse_utc_minutes(const std::string& utc) {
     return minutes;
 }
 
+// Upper bound: every data line emits one record per year column
+static size_t worldbank_rows_bound(size_t lines, const std::string& headerLine) {
+    std::vector<std::string> header;
+    CSVParser::splitLine(headerLine, header);
+    size_t years = 0;
+    for (size_t c = 4; c < header.size(); ++c) {
+        if (header[c].size()==4 && header[c][0] >= '0' && header[c][0] <= '9') ++years;
+    }
+    return lines > 0 ? (lines - 1) * years : 0;
+}
+
+size_t VectorDataSource::estimate_fire_rows(const std::string& path) {
+    return CSVParser::countLines(path);   // headerless, one record per line
+}
+
+size_t VectorDataSource::estimate_worldbank_rows(const std::string& path) {
+    std::string headerLine;
+    size_t lines = CSVParser::countLines(path, 0, UINT64_MAX, &headerLine);
+    return worldbank_rows_bound(lines, headerLine);
+}
+
 void VectorDataSource::load_fire_data(const std::string& path) {
-    load_fire_data_thread_local(path, fire_records_, dictionaries_);
+    const size_t base = fire_records_.size();
+    const size_t cap = estimate_fire_rows(path);
+    fire_records_.resize(base + cap);
+    LoadTask task; task.path = path; task.end = UINT64_MAX;
+    size_t n = parse_fire_file(task, fire_records_.data() + base, cap, dictionaries_);
+    fire_records_.resize(base + n);
 }
 
-void VectorDataSource::load_fire_data_thread_local(const std::string& path, FireRecords& records, Dictionaries& dicts) {
-    CSVParser csv(path, /*hasHeader=*/false);
-    std::vector<std::string> row;
-    while (csv.next(row)) {
-        if (row.size() < 12) continue;
-
-        double lat_d, lon_d, value_d, raw_d;
-        if (!to_double(row[0], lat_d)) continue;
-        if (!to_double(row[1], lon_d)) continue;
-        float lat = (float)lat_d, lon = (float)lon_d;
-        
-        const std::string& utc = row[2];
-        long long utc_minutes = parse_utc_minutes(utc);
-        
-        // Thread-local dictionary operations (no critical sections needed)
-        auto get_or_add_local = [&dicts](std::unordered_map<std::string, uint32_t>& dict, const std::string& key) -> uint32_t {
-            auto it = dict.find(key);
-            if (it != dict.end()) return it->second;
-            uint32_t id = (uint32_t)dict.size();
-            dict.emplace(key, id);
-            return id;
-        };
-        
-        uint32_t paramId = get_or_add_local(dicts.parameter_dict, row[3]);
-        uint32_t unitId  = get_or_add_local(dicts.unit_dict, row[5]);
-        
-        float value = std::numeric_limits<float>::quiet_NaN(); 
-        if (!row[4].empty() && to_double(row[4], value_d) && value_d != -999.0) value = (float)value_d;
-        float raw = std::numeric_limits<float>::quiet_NaN(); 
-        if (!row[6].empty() && to_double(row[6], raw_d) && raw_d != -999.0) raw = (float)raw_d;
-        
-        int aqi = -999; if (!row[7].empty()) { int v=0; if (to_int(row[7], v)) aqi = v; }
-        uint8_t cat = 0; if (!row[8].empty()) { int v=0; if (to_int(row[8], v)) cat = (uint8_t)v; }
-        uint32_t siteId   = get_or_add_local(dicts.site_dict, row[9]);
-        uint32_t agencyId = get_or_add_local(dicts.agency_dict, row[10]);
-        uint32_t aqsId    = get_or_add_local(dicts.aqs_dict, row[11]);
-
-        // Derived fields
-        int yr = 0;
-        if (utc.size()>=4) { int v=0; if (to_int(utc.substr(0,4), v)) yr = v; }
-        double numericVal = std::isnan(value) ? 0.0 : value;
-
-        // Direct construction in place (no copy) - no critical section needed
-        records.emplace_back(lat, lon, (int32_t)utc_minutes, (uint16_t)paramId, (uint16_t)unitId,
-                            value, raw, (int16_t)aqi, cat, siteId, agencyId, aqsId, yr, numericVal);
+size_t VectorDataSource::parse_fire_file(const LoadTask& task, FireRecord* out, size_t capacity, Dictionaries& dicts) {
+    size_t n = 0;
+    CSVParser csv(task.path, /*hasHeader=*/false);
+    csv.setRange(task.begin, task.end);
+    // Projection: fields outside it are delimited, never copied or converted
+    const uint32_t fields = options_.fireFields | fire_field_bit(FireField::Latitude) | fire_field_bit(FireField::Longitude);
+    auto loads = [fields](FireField f) { return (fields & fire_field_bit(f)) != 0; };
+    csv.setFields(fields);
+
+    // Rows go through in batches: coordinates first, then every dictionary
+    // column encoded for the whole batch (hash, prefetch, probe), then the
+    // remaining fields. File-local dictionaries, so no critical sections.
+    constexpr size_t kBatch = BatchEncoder<std::string>::kBatch;
+    enum { Parameter, Unit, SiteName, Agency, Aqs, Columns };
+    static constexpr FireField kColumn[Columns] = {
+        FireField::Parameter, FireField::Unit, FireField::SiteName, FireField::Agency, FireField::Aqs};
+    BatchEncoder<std::string> encoders[Columns] = {
+        {dicts.parameter_names}, {dicts.unit_names}, {dicts.site_names}, {dicts.agency_names}, {dicts.aqs_names}};
+    std::vector<std::string>* names[Columns] = {
+        &dicts.parameter_names, &dicts.unit_names, &dicts.site_names, &dicts.agency_names, &dicts.aqs_names};
+    BatchEncoder<SiteRecord, SiteRecordHash> siteRows(dicts.sites);
+
+    std::vector<std::vector<std::string>> rows(kBatch);
+    std::vector<SiteRecord> sites(kBatch);
+    std::vector<const std::string*> keys(kBatch);
+    std::vector<const SiteRecord*> siteKeys(kBatch);
+    std::vector<uint32_t> ids[Columns], siteIds(kBatch);
+    for (auto& column : ids) column.resize(kBatch);
+
+    bool more = true;
+    while (more && n < capacity) {
+        size_t m = 0;
+        while (m < kBatch && n + m < capacity) {
+            if (!csv.next(rows[m])) { more = false; break; }
+            const auto& row = rows[m];
+            double lat_d, lon_d;
+            if (row.size() < 12) continue;
+            if (!to_double(row[0], lat_d)) continue;
+            if (!to_double(row[1], lon_d)) continue;
+            sites[m].latitude = (float)lat_d;
+            sites[m].longitude = (float)lon_d;
+            ++m;
+        }
+
+        for (size_t c = 0; c < Columns; ++c) {
+            if (!loads(kColumn[c])) {
+                // Skipped: every row gets id 0, the empty name
+                if (m && names[c]->empty()) names[c]->emplace_back();
+                std::fill(ids[c].begin(), ids[c].begin() + m, 0u);
+                continue;
+            }
+            for (size_t k = 0; k < m; ++k) keys[k] = &rows[k][(size_t)kColumn[c]];
+            encoders[c].encode(keys.data(), m, ids[c].data());
+        }
+        // Static monitor attributes go to the site dimension; the row keeps its id
+        for (size_t k = 0; k < m; ++k) {
+            sites[k].name_id   = ids[SiteName][k];
+            sites[k].agency_id = ids[Agency][k];
+            sites[k].aqs_id    = ids[Aqs][k];
+            siteKeys[k] = &sites[k];
+        }
+        siteRows.encode(siteKeys.data(), m, siteIds.data());
+
+        for (size_t k = 0; k < m; ++k) {
+            const auto& row = rows[k];
+            double value_d, raw_d;
+            // Skipped fields are empty strings here and keep the defaults
+            const std::string& utc = row[2];
+            long long utc_minutes = parse_utc_minutes(utc);
+
+            float value = std::numeric_limits<float>::quiet_NaN(); 
+            if (!row[4].empty() && to_double(row[4], value_d) && value_d != -999.0) value = (float)value_d;
+            float raw = std::numeric_limits<float>::quiet_NaN(); 
+            if (!row[6].empty() && to_double(row[6], raw_d) && raw_d != -999.0) raw = (float)raw_d;
+            
+            int aqi = -999; if (!row[7].empty()) { int v=0; if (to_int(row[7], v)) aqi = v; }
+            uint8_t cat = 0; if (!row[8].empty()) { int v=0; if (to_int(row[8], v)) cat = (uint8_t)v; }
+
+            // Derived fields
+            int yr = 0;
+            if (utc.size()>=4) { int v=0; if (to_int(utc.substr(0,4), v)) yr = v; }
+            double numericVal = std::isnan(value) ? 0.0 : value;
+
+            // Written straight into this file's slot of the shared array
+            out[n++] = FireRecord((int32_t)utc_minutes, (uint16_t)ids[Parameter][k], (uint16_t)ids[Unit][k],
+                                  value, raw, (int16_t)aqi, cat, siteIds[k], yr, numericVal);
+        }
     }
+    int32_t newest = INT32_MIN;
+    for (size_t i = 0; i < n; ++i) newest = std::max(newest, out[i].utc_minutes);
+    record_file_ingested(n, task.firstChunk ? 1 : 0, newest);
+    return n;
 }
 
 void VectorDataSource::load_worldbank_data(const std::string& path) {
-    load_worldbank_data_thread_local(path, worldbank_records_, dictionaries_);
+    const size_t base = worldbank_records_.size();
+    const size_t cap = estimate_worldbank_rows(path);
+    worldbank_records_.resize(base + cap);
+    LoadTask task; task.path = path; task.end = UINT64_MAX;
+    size_t n = parse_worldbank_file(task, worldbank_records_.data() + base, cap, dictionaries_);
+    worldbank_records_.resize(base + n);
 }
 
-void VectorDataSource::load_worldbank_data_thread_local(const std::string& path, WorldBankRecords& records, Dictionaries& dicts) {
-    CSVParser csv(path, /*hasHeader=*/true);
+size_t VectorDataSource::parse_worldbank_file(const LoadTask& task, WorldBankRecord* out, size_t capacity, Dictionaries& dicts) {
+    size_t n = 0;
+    CSVParser csv(task.path, /*hasHeader=*/true);
     std::vector<std::string> header;
     csv.readHeader(header);
 
     std::vector<std::string> row;
-    while (csv.next(row)) {
+    while (n < capacity && csv.next(row)) {
         if (row.size() < 5) continue;
         const std::string countryName = row[0];
         const std::string countryCode = row[1];
         const std::string indicatorName = row[2];
         const std::string indicatorCode = row[3];
 
-        // Thread-local dictionary operations (no critical sections needed)
-        auto get_or_add_local_32 = [&dicts](std::unordered_map<std::string, uint32_t>& dict, const std::string& key) -> uint32_t {
-            auto it = dict.find(key);
-            if (it != dict.end()) return it->second;
-            uint32_t id = (uint32_t)dict.size();
-            dict.emplace(key, id);
-            return id;
-        };
-        
-        auto get_or_add_local_16 = [&dicts](std::unordered_map<std::string, uint16_t>& dict, const std::string& key) -> uint16_t {
-            auto it = dict.find(key);
-            if (it != dict.end()) return it->second;
-            uint16_t id = (uint16_t)dict.size();
-            dict.emplace(key, id);
-            return id;
-        };
-
-        uint32_t cn_id = get_or_add_local_32(dicts.country_name_dict, countryName);
-        uint32_t cc_id = get_or_add_local_32(dicts.country_code_dict, countryCode);
-        uint16_t indicator_id = get_or_add_local_16(dicts.indicator_dict, indicatorName + "|" + indicatorCode);
-
-        for (size_t c=4; c<row.size(); ++c) {
+        // File-local dictionary operations (no critical sections needed)
+        uint32_t cn_id = dict_get_or_add_named(dicts.country_name_dict, dicts.country_names, countryName);
+        uint32_t cc_id = dict_get_or_add_named(dicts.country_code_dict, dicts.country_codes, countryCode);
+        uint16_t indicator_id = dict_get_or_add_named(dicts.indicator_dict, dicts.indicator_names, indicatorName + "|" + indicatorCode);
+
+        for (size_t c=4; c<row.size() && n < capacity; ++c) {
             if (c < header.size() && header[c].size()==4 && (header[c][0] >= '0' && header[c][0] <= '9')) {
                 int yr=0; if (!to_int(header[c], yr)) continue;
                 double val; if (row[c].empty() || !to_double(row[c], val)) continue;
 
-                // Direct construction in place (no copy) - no critical section needed
-                records.emplace_back(cn_id, cc_id, indicator_id, (int16_t)yr, val, val);
+                out[n++] = WorldBankRecord(cn_id, cc_id, indicator_id, (int16_t)yr, val, val);
             }
         }
     }
+    record_file_ingested(n, task.firstChunk ? 1 : 0);
+    return n;
+}
+
+// -------- two-phase ordered directory load --------
+// Phase 2: parse every task straight into its slot, largest task first
+// (LPT) so a big file picked late cannot leave one thread running alone.
+// Returns rows written per task; threadFinish receives per-thread finish
+// times in seconds.
+template <typename Rec, typename ParseFn>
+static std::vector<size_t> parse_into_slots(const std::vector<LoadTask>& tasks, const std::vector<size_t>& capacity,
+                                            std::vector<Rec>& out, std::vector<size_t>& offsets,
+                                            std::vector<Dictionaries>& taskDicts, std::vector<double>& threadFinish,
+                                            ParseFn parse)
+{
+    offsets.assign(tasks.size() + 1, 0);
+    for (size_t i = 0; i < tasks.size(); ++i) offsets[i + 1] = offsets[i] + capacity[i];
+    out.resize(offsets.back());
+
+    const std::vector<size_t> order = LoadPlanner::largestFirst(tasks);
+    const long long n = (long long)order.size();
+    std::vector<size_t> written(tasks.size(), 0);
+    const auto t0 = std::chrono::steady_clock::now();
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 1) nowait
+        for (long long k = 0; k < n; ++k) {
+            const size_t i = order[k];
+            written[i] = parse(tasks[i], out.data() + offsets[i], capacity[i], taskDicts[i]);
+        }
+        double done = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        #pragma omp critical
+        threadFinish.push_back(done);
+    }
+    return written;
+}
+
+// Close gaps left by skipped rows. Estimates are exact for well-formed files,
+// so this only moves data when some file had malformed or empty rows.
+template <typename Rec>
+static void compact_slots(std::vector<Rec>& out, const std::vector<size_t>& offsets, const std::vector<size_t>& written) {
+    size_t dst = 0;
+    for (size_t i = 0; i < written.size(); ++i) {
+        if (dst != offsets[i]) {
+            std::move(out.begin() + offsets[i], out.begin() + offsets[i] + written[i], out.begin() + dst);
+        }
+        dst += written[i];
+    }
+    out.resize(dst);
+}
+
+void VectorDataSource::load_directory(const std::vector<LoadTask>& files) {
+    if (files.empty()) return;
+
+    // Phase 1: line counts per task (largest first); the first line of each
+    // file doubles as the dataset sniff and the WorldBank header.
+    std::vector<LoadTask> tasks = LoadPlanner::splitOversized(files, options_.chunkBytes);
+    std::vector<size_t> lines(tasks.size());
+    std::vector<std::string> firstLines(tasks.size());
+    {
+        const std::vector<size_t> order = LoadPlanner::largestFirst(tasks);
+        const long long n = (long long)order.size();
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long k = 0; k < n; ++k) {
+            const size_t i = order[k];
+            lines[i] = CSVParser::countLines(tasks[i].path, tasks[i].begin, tasks[i].end,
+                                             tasks[i].firstChunk ? &firstLines[i] : nullptr);
+        }
+    }
+
+    std::vector<std::string> first;
+    CSVParser::splitLine(firstLines[0], first);
+    dataset_ = (isPopulationHeader(first) || !looksLikeFireRow(first)) ? Dataset::WorldBank : Dataset::Fire;
+
+    if (dataset_ == Dataset::WorldBank && tasks.size() != files.size()) {
+        // Headered files cannot be split; fold chunk counts back per file
+        std::vector<size_t> fileLines;
+        std::vector<std::string> fileFirst;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            if (tasks[i].firstChunk) { fileLines.push_back(0); fileFirst.push_back(std::move(firstLines[i])); }
+            fileLines.back() += lines[i];
+        }
+        tasks = files;
+        lines = std::move(fileLines);
+        firstLines = std::move(fileFirst);
+    }
+
+    const long long n = (long long)tasks.size();
+    std::vector<size_t> capacity(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        capacity[i] = dataset_ == Dataset::Fire ? lines[i] : worldbank_rows_bound(lines[i], firstLines[i]);
+    }
+
+    std::vector<Dictionaries> taskDicts(tasks.size());
+    std::vector<size_t> offsets;
+    std::vector<double> threadFinish;
+
+    if (dataset_ == Dataset::Fire) {
+        auto written = parse_into_slots(tasks, capacity, fire_records_, offsets, taskDicts, threadFinish,
+            [this](const LoadTask& t, FireRecord* out, size_t cap, Dictionaries& d) {
+                return parse_fire_file(t, out, cap, d);
+            });
+        auto remaps = merge_dictionaries(dictionaries_, taskDicts);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long i = 0; i < n; ++i) {
+            FireRecord* rows = fire_records_.data() + offsets[i];
+            for (size_t j = 0; j < written[i]; ++j) remaps[i].apply(rows[j]);
+        }
+        compact_slots(fire_records_, offsets, written);
+    } else {
+        auto written = parse_into_slots(tasks, capacity, worldbank_records_, offsets, taskDicts, threadFinish,
+            [this](const LoadTask& t, WorldBankRecord* out, size_t cap, Dictionaries& d) {
+                return parse_worldbank_file(t, out, cap, d);
+            });
+        auto remaps = merge_dictionaries(dictionaries_, taskDicts);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long i = 0; i < n; ++i) {
+            WorldBankRecord* rows = worldbank_records_.data() + offsets[i];
+            for (size_t j = 0; j < written[i]; ++j) remaps[i].apply(rows[j]);
+        }
+        compact_slots(worldbank_records_, offsets, written);
+    }
+
+    MetricsRegistry::instance()
+        .gauge("mini1_load_tail_seconds", "Parse phase: last thread finish minus median thread finish", "impl=\"vector\"")
+        .set(LoadPlanner::tailSeconds(threadFinish));
+}
+
+// Name-ordered ids, so id ranges are name ranges; rows remap in parallel
+void VectorDataSource::finalize_dictionaries() {
+    const DictionaryRemap remap = sort_dictionaries(dictionaries_);
+    auto apply_all = [&](auto& rows) {
+        const long long n = (long long)rows.size();
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; ++i) remap.apply(rows[i]);
+    };
+    if (dataset_ == Dataset::Fire) apply_all(fire_records_);
+    else apply_all(worldbank_records_);
+    freeze_dictionaries(dictionaries_);
+}
+
+// -------- physical reorganization --------
+void VectorDataSource::reorganize() {
+    const double before = Clustering::compressionRatio(fire_records_, ZoneMap::kBlockRows);
+    auto start = std::chrono::steady_clock::now();
+    Clustering::permute(fire_records_, Clustering::order(fire_records_, dictionaries_.sites, options_.clustering));
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double after = Clustering::compressionRatio(fire_records_, ZoneMap::kBlockRows);
+
+    auto& reg = MetricsRegistry::instance();
+    const std::string impl = "impl=\"vector\"";
+    reg.gauge("mini1_reorganize_seconds", "Wall time of the post-load clustering sort", impl).set(seconds);
+    reg.gauge("mini1_compression_ratio", "Estimated per-block FOR/RLE compression ratio of fire rows",
+              impl + ",order=\"load\"").set(before);
+    reg.gauge("mini1_compression_ratio", "Estimated per-block FOR/RLE compression ratio of fire rows",
+              impl + ",order=\"clustered\"").set(after);
+}
+
+// Visit rows of the blocks whose zone may hold the field in [lo, hi], in row order.
+template <typename Fn>
+void VectorDataSource::scan_zones(ZoneMap::Field field, double lo, double hi, Fn fn) const {
+    static Counter& scanned = MetricsRegistry::instance().counter(
+        "mini1_zone_blocks_total", "Zone map blocks considered by scans", "impl=\"vector\",outcome=\"scanned\"");
+    static Counter& skipped = MetricsRegistry::instance().counter(
+        "mini1_zone_blocks_total", "Zone map blocks considered by scans", "impl=\"vector\",outcome=\"skipped\"");
+    size_t kept = 0;
+    for (size_t b = 0; b < zones_.blocks(); ++b) {
+        if (!zones_.mayContain(field, b, lo, hi)) continue;
+        ++kept;
+        for (size_t i = zones_.blockBegin(b); i < zones_.blockEnd(b); ++i) fn(fire_records_[i]);
+    }
+    scanned.inc(kept);
+    skipped.inc(zones_.blocks() - kept);
+}
+
+// Visit rows of the hours whose Bloom filter may hold a key in [lo, hi], in row order.
+template <typename Fn>
+void VectorDataSource::scan_segments(SegmentBloom::Key key, long long lo, long long hi, Fn fn) const {
+    static Counter& scanned = MetricsRegistry::instance().counter(
+        "mini1_bloom_segments_total", "Hourly segments considered by site id scans", "impl=\"vector\",outcome=\"scanned\"");
+    static Counter& skipped = MetricsRegistry::instance().counter(
+        "mini1_bloom_segments_total", "Hourly segments considered by site id scans", "impl=\"vector\",outcome=\"skipped\"");
+    const size_t skips = segment_bloom_.forEachRun(key, lo, hi, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) fn(fire_records_[i]);
+    });
+    scanned.inc(segment_bloom_.segments() - skips);
+    skipped.inc(skips);
+}
+
+// -------- ordered indexes --------
+// (key, row) pairs of one fire column, in row order
+template <typename KeyFn>
+static auto column_pairs(const FireRecords& records, KeyFn key) {
+    using K = decltype(key(records.front()));
+    std::vector<std::pair<K, uint32_t>> pairs(records.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)records.size(); ++i) pairs[i] = {key(records[i]), (uint32_t)i};
+    return pairs;
+}
+
+static double value_key(const FireRecord& r) { return r.numericValue; }
+static int32_t utc_key(const FireRecord& r) { return r.utc_minutes; }
+static int32_t aqi_key(const FireRecord& r) { return r.aqi; }
+
+void VectorDataSource::build_ordered_indexes() {
+    if (options_.orderedIndex == LoadOptions::OrderedIndex::BitSliced) {
+        std::vector<double> value(fire_records_.size()), raw(fire_records_.size());
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < (long long)fire_records_.size(); ++i) {
+            value[i] = fire_records_[i].numericValue;
+            raw[i] = fire_records_[i].raw_value;
+        }
+        value_bsi_.build(value);
+        raw_bsi_.build(raw);
+        return;
+    }
+    if (options_.orderedIndex != LoadOptions::OrderedIndex::BTree &&
+        options_.orderedIndex != LoadOptions::OrderedIndex::Eytzinger) return;
+
+    // Per column: (key, row) pairs and a parallel radix sort using every
+    // thread; ties stay in row order. The three bulk loads run concurrently.
+    auto sorted = [this](auto key) {
+        auto pairs = column_pairs(fire_records_, key);
+        parallel_radix_sort(pairs);
+        return pairs;
+    };
+    const auto value = sorted(value_key);
+    const auto utc = sorted(utc_key);
+    const auto aqi = sorted(aqi_key);
+
+    if (options_.orderedIndex == LoadOptions::OrderedIndex::BTree) {
+        #pragma omp parallel sections
+        {
+            #pragma omp section
+            value_tree_.bulkLoad(value);
+            #pragma omp section
+            utc_tree_.bulkLoad(utc);
+            #pragma omp section
+            aqi_tree_.bulkLoad(aqi);
+        }
+    } else {
+        #pragma omp parallel sections
+        {
+            #pragma omp section
+            value_eytz_.bulkLoad(value);
+            #pragma omp section
+            utc_eytz_.bulkLoad(utc);
+            #pragma omp section
+            aqi_eytz_.bulkLoad(aqi);
+        }
+    }
+}
+
+// -------- spatial --------
+const SiteIndex& VectorDataSource::siteIndex() const {
+    std::call_once(site_index_once_, [this]() { site_index_.build(fire_records_, dictionaries_.sites); });
+    return site_index_;
+}
+
+const PointIndex& VectorDataSource::pointIndex() const {
+    std::call_once(point_index_once_, [this]() { point_index_.build(fire_records_); });
+    return point_index_;
+}
+
+RecordViews VectorDataSource::lookup(uint32_t siteId, uint16_t parameterId, int32_t utcMinutes) const {
+    RecordViews results;
+    if (dataset_ != Dataset::Fire) return results;
+    pointIndex().forEach(siteId, parameterId, utcMinutes, [&](uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+    return results;
+}
+
+std::vector<std::optional<RecordView>> VectorDataSource::lookupBatch(const std::vector<PointIndex::Key>& keys) const {
+    std::vector<std::optional<RecordView>> results(keys.size());
+    if (dataset_ != Dataset::Fire) return results;
+    std::vector<uint32_t> rows(keys.size());
+    pointIndex().lookupBatch(keys.data(), keys.size(), rows.data());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (rows[i] != PointIndex::kNotFound) results[i] = fire_to_view(fire_records_[rows[i]]);
+    }
+    return results;
+}
+
+std::vector<NearbySite> VectorDataSource::kNearestSites(double lat, double lon, size_t k) const {
+    std::vector<NearbySite> out;
+    if (dataset_ != Dataset::Fire) return out;
+    const SiteIndex& index = siteIndex();
+    for (const auto& n : index.nearest(lat, lon, k)) {
+        const SiteIndex::Site& site = index.sites()[n.site];
+        NearbySite ns;
+        ns.site_id = site.site_id;
+        ns.distance_km = n.distance_km;
+        for (uint32_t row : index.latestRows(site, fire_records_)) ns.latest.push_back(fire_to_view(fire_records_[row]));
+        out.push_back(std::move(ns));
+    }
+    return out;
+}
+
+RecordViews VectorDataSource::findNear(double lat, double lon, double radiusKm, int32_t utcFrom, int32_t utcTo) const {
+    if (dataset_ != Dataset::Fire) return {};
+    std::call_once(near_index_once_, [this]() { near_index_.build(fire_records_, dictionaries_.sites); });
+    RecordViews results;
+    for (uint32_t row : near_index_.findNear(fire_records_, dictionaries_.sites, lat, lon, radiusKm, utcFrom, utcTo)) {
+        results.push_back(fire_to_view(fire_records_[row]));
+    }
+    return results;
+}
+
+RecordViews VectorDataSource::findWithin(const PolygonFilter& fence) const {
+    if (dataset_ != Dataset::Fire) return {};
+    RecordViews results;
+    for (uint32_t row : fence.filter(fire_records_, dictionaries_.sites)) results.push_back(fire_to_view(fire_records_[row]));
+    return results;
+}
+
+Raster VectorDataSource::interpolateIdw(uint16_t parameterId, int32_t utcFrom, int32_t utcTo,
+                                        const GridSpec& grid, const IdwOptions& options) const {
+    if (dataset_ != Dataset::Fire) return {};
+    return IdwInterpolator(fire_records_, siteIndex()).interpolate(parameterId, utcFrom, utcTo, grid, options);
+}
+
+// -------- metrics --------
+void VectorDataSource::record_file_ingested(size_t rows, size_t files, int32_t newestUtc) const {
+    static Counter& filesIngested = MetricsRegistry::instance().counter(
+        "mini1_files_ingested_total", "CSV files ingested", "impl=\"vector\"");
+    static Counter& rowsIngested = MetricsRegistry::instance().counter(
+        "mini1_rows_ingested_total", "Records ingested", "impl=\"vector\"");
+    filesIngested.inc(files);
+    rowsIngested.inc(rows);
+
+    // Live ingest lag, as tasks finish; publish_load_metrics sets the final value
+    if (newestUtc != INT32_MIN) ingest_lag_.observe(newestUtc);
+}
+
+void VectorDataSource::publish_load_metrics() const {
+    auto& reg = MetricsRegistry::instance();
+    const std::string impl = "impl=\"vector\"";
+    reg.gauge("mini1_records", "Records held", impl)
+        .set((double)(dataset_ == Dataset::Fire ? fire_records_.size() : worldbank_records_.size()));
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"fire_records\"")
+        .set((double)(fire_records_.capacity() * sizeof(FireRecord)));
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"worldbank_records\"")
+        .set((double)(worldbank_records_.capacity() * sizeof(WorldBankRecord)));
+    reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"dictionaries\"")
+        .set((double)dictionaries_memory_bytes(dictionaries_));
+    if (value_tree_.size()) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"btree_index\"")
+            .set((double)(value_tree_.memoryBytes() + utc_tree_.memoryBytes() + aqi_tree_.memoryBytes()));
+    }
+    if (zones_.blocks()) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"zone_map\"")
+            .set((double)zones_.memoryBytes());
+    }
+    if (segment_bloom_.segments()) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"segment_bloom\"")
+            .set((double)segment_bloom_.memoryBytes());
+    }
+    if (options_.pointIndex && dataset_ == Dataset::Fire) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"point_index\"")
+            .set((double)point_index_.memoryBytes());
+    }
+    if (heatmap_) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"heatmap_tiles\"")
+            .set((double)heatmap_->memoryBytes());
+    }
+    if (value_bsi_.size()) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"bitsliced_index\"")
+            .set((double)(value_bsi_.memoryBytes() + raw_bsi_.memoryBytes()));
+    }
+    if (value_eytz_.size()) {
+        reg.gauge("mini1_memory_bytes", "Approximate memory by structure", impl + ",structure=\"eytzinger_index\"")
+            .set((double)(value_eytz_.memoryBytes() + utc_eytz_.memoryBytes() + aqi_eytz_.memoryBytes()));
+    }
+
+    // Ingest lag: wall clock minus the newest observation timestamp
+    if (dataset_ == Dataset::Fire && !fire_records_.empty()) {
+        int32_t newest = std::max_element(fire_records_.begin(), fire_records_.end(),
+            [](const FireRecord& a, const FireRecord& b) { return a.utc_minutes < b.utc_minutes; })->utc_minutes;
+        ingest_lag_.observe(newest);
+    }
 }
 
 // -------- conversion helpers --------
@@ -307,15 +671,16 @@ RecordView VectorDataSource::fire_to_view(const FireRecord& record) const {
     view.type = RecordView::Type::Fire;
     view.year = record.year;
     view.numericValue = record.numericValue;
-    view.latitude = record.latitude;
-    view.longitude = record.longitude;
+    const SiteRecord& site = dictionaries_.sites[record.site_id];
+    view.latitude = site.latitude;
+    view.longitude = site.longitude;
     view.value = record.value;
     view.aqi = record.aqi;
     view.parameter_id = record.parameter_id;
     view.unit_id = record.unit_id;
-    view.site_id = record.site_id;
-    view.agency_id = record.agency_id;
-    view.aqs_id = record.aqs_id;
+    view.site_id = site.name_id;
+    view.agency_id = site.agency_id;
+    view.aqs_id = site.aqs_id;
     return view;
 }
 
@@ -333,35 +698,60 @@ RecordView VectorDataSource::worldbank_to_view(const WorldBankRecord& record) co
 // -------- column-aware API (all scans) --------
 RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, const std::string& hiS) {
     RecordViews results;
+    // Projected out at load: the rows only hold defaults for col
+    if (dataset_ == Dataset::Fire && !options_.loadsColumn(col)) return {};
     
     if (dataset_ == Dataset::Fire) {
         // Fire-specific queries
     switch (col) {
             case Column::Value: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                if (value_tree_.size()) {
+                    // Index order: by value, then load order
+                    value_tree_.scan(lo, hi, [&](double, uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (value_eytz_.size()) {
+                    value_eytz_.scan(lo, hi, [&](uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (value_bsi_.size()) {
+                    BitSlicedIndex::forEachRow(value_bsi_.select(lo, hi),
+                        [&](uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (options_.orderedIndex == LoadOptions::OrderedIndex::Cracking) {
+                    for (uint32_t row : value_crack_.rows(lo, hi, [&] { return column_pairs(fire_records_, value_key); })) {
+                        results.push_back(fire_to_view(fire_records_[row]));
+                    }
+                    break;
+                }
+                scan_zones(ZoneMap::Field::Value, lo, hi, [&](const FireRecord& record) {
                     if (record.numericValue >= lo && record.numericValue <= hi) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::Latitude: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
-                    if (record.latitude >= lo && record.latitude <= hi) {
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                // Site attribute: test each dimension row once, then rows by site_id
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return s.latitude >= lo && s.latitude <= hi; });
+                scan_zones(ZoneMap::Field::Latitude, lo, hi, [&](const FireRecord& record) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::Longitude: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
-                    if (record.longitude >= lo && record.longitude <= hi) {
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return s.longitude >= lo && s.longitude <= hi; });
+                scan_zones(ZoneMap::Field::Longitude, lo, hi, [&](const FireRecord& record) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::Year: {
@@ -374,7 +764,12 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
                 break;
             }
             case Column::RawValue: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
+                if (raw_bsi_.size()) {
+                    BitSlicedIndex::forEachRow(raw_bsi_.select(lo, hi),
+                        [&](uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
                 for (const auto& record : fire_records_) {
                     if (!std::isnan(record.raw_value) && record.raw_value >= lo && record.raw_value <= hi) {
                         results.push_back(fire_to_view(record));
@@ -384,11 +779,25 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
             }
             case Column::AQI: {
                 int lo=0, hi=0; if(!to_int(loS,lo)||!to_int(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
+                if (aqi_tree_.size()) {
+                    aqi_tree_.scan(lo, hi, [&](int32_t, uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (aqi_eytz_.size()) {
+                    aqi_eytz_.scan(lo, hi, [&](uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (options_.orderedIndex == LoadOptions::OrderedIndex::Cracking) {
+                    for (uint32_t row : aqi_crack_.rows(lo, hi, [&] { return column_pairs(fire_records_, aqi_key); })) {
+                        results.push_back(fire_to_view(fire_records_[row]));
+                    }
+                    break;
+                }
+                scan_zones(ZoneMap::Field::AQI, lo, hi, [&](const FireRecord& record) {
                     if (record.aqi >= lo && record.aqi <= hi) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::Category: {
@@ -402,20 +811,38 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
             }
             case Column::UTCMinutes: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
+                auto clamp32 = [](long long v) {
+                    return (int32_t)std::max<long long>(INT32_MIN, std::min<long long>(INT32_MAX, v));
+                };
+                if (utc_tree_.size()) {
+                    utc_tree_.scan(clamp32(lo), clamp32(hi),
+                        [&](int32_t, uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (utc_eytz_.size()) {
+                    utc_eytz_.scan(clamp32(lo), clamp32(hi), [&](uint32_t row) { results.push_back(fire_to_view(fire_records_[row])); });
+                    break;
+                }
+                if (options_.orderedIndex == LoadOptions::OrderedIndex::Cracking) {
+                    for (uint32_t row : utc_crack_.rows(clamp32(lo), clamp32(hi), [&] { return column_pairs(fire_records_, utc_key); })) {
+                        results.push_back(fire_to_view(fire_records_[row]));
+                    }
+                    break;
+                }
+                scan_zones(ZoneMap::Field::UTCMinutes, (double)lo, (double)hi, [&](const FireRecord& record) {
                     if (record.utc_minutes >= lo && record.utc_minutes <= hi) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::ParameterId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
+                scan_zones(ZoneMap::Field::ParameterId, (double)lo, (double)hi, [&](const FireRecord& record) {
                     if ((long long)record.parameter_id >= lo && (long long)record.parameter_id <= hi) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::UnitId: {
@@ -429,31 +856,66 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
             }
             case Column::SiteId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
-                    if ((long long)record.site_id >= lo && (long long)record.site_id <= hi) {
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return (long long)s.name_id >= lo && (long long)s.name_id <= hi; });
+                scan_segments(SegmentBloom::Key::Site, lo, hi, [&](const FireRecord& record) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::AgencyId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
-                for (const auto& record : fire_records_) {
-                    if ((long long)record.agency_id >= lo && (long long)record.agency_id <= hi) {
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return (long long)s.agency_id >= lo && (long long)s.agency_id <= hi; });
+                scan_segments(SegmentBloom::Key::Agency, lo, hi, [&](const FireRecord& record) {
+                    if (match[record.site_id]) {
                         results.push_back(fire_to_view(record));
                     }
-                }
+                });
                 break;
             }
             case Column::AqsId: {
                 long long lo=0, hi=0; if(!to_ll(loS,lo)||!to_ll(hiS,hi)||lo>hi) return {};
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) { return (long long)s.aqs_id >= lo && (long long)s.aqs_id <= hi; });
+                scan_segments(SegmentBloom::Key::Aqs, lo, hi, [&](const FireRecord& record) {
+                    if (match[record.site_id]) {
+                        results.push_back(fire_to_view(record));
+                    }
+                });
+                break;
+            }
+            case Column::ParameterName:
+            case Column::UnitName: {
+                // Name-ordered dictionaries: the name range is an id range
+                const bool param = col == Column::ParameterName;
+                const auto range = (param ? dictionaries_.frozen.parameter : dictionaries_.frozen.unit).idRange(loS, hiS);
                 for (const auto& record : fire_records_) {
-                    if ((long long)record.aqs_id >= lo && (long long)record.aqs_id <= hi) {
+                    const uint32_t id = param ? record.parameter_id : record.unit_id;
+                    if (id >= range.first && id < range.second) {
                         results.push_back(fire_to_view(record));
                     }
                 }
                 break;
             }
+            case Column::SiteName:
+            case Column::AgencyName:
+            case Column::AqsName: {
+                const FrozenDictionary& names = col == Column::SiteName ? dictionaries_.frozen.site
+                    : col == Column::AgencyName ? dictionaries_.frozen.agency : dictionaries_.frozen.aqs;
+                const auto range = names.idRange(loS, hiS);
+                const auto match = select_sites(dictionaries_.sites, [&](const SiteRecord& s) {
+                    const uint32_t id = col == Column::SiteName ? s.name_id : col == Column::AgencyName ? s.agency_id : s.aqs_id;
+                    return id >= range.first && id < range.second;
+                });
+                const auto key = col == Column::SiteName ? SegmentBloom::Key::Site
+                    : col == Column::AgencyName ? SegmentBloom::Key::Agency : SegmentBloom::Key::Aqs;
+                scan_segments(key, range.first, (long long)range.second - 1, [&](const FireRecord& record) {
+                    if (match[record.site_id]) {
+                        results.push_back(fire_to_view(record));
+                    }
+                });
+                break;
+            }
             default:
                 return {}; // Unsupported column for Fire dataset
         }
@@ -461,7 +923,7 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
         // WorldBank-specific queries
         switch (col) {
         case Column::Population: {
-                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||lo>hi) return {};
+                double lo=0, hi=0; if(!to_double(loS,lo)||!to_double(hiS,hi)||!(lo<=hi)) return {};
                 for (const auto& record : worldbank_records_) {
                     if (record.population >= lo && record.population <= hi) {
                         results.push_back(worldbank_to_view(record));
@@ -496,6 +958,18 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
                 }
                 break;
             }
+            case Column::WB_CountryName:
+            case Column::WB_CountryCode: {
+                const bool name = col == Column::WB_CountryName;
+                const auto range = (name ? dictionaries_.frozen.country_name : dictionaries_.frozen.country_code).idRange(loS, hiS);
+                for (const auto& record : worldbank_records_) {
+                    const uint32_t id = name ? record.country_name_id : record.country_code_id;
+                    if (id >= range.first && id < range.second) {
+                        results.push_back(worldbank_to_view(record));
+                    }
+                }
+                break;
+            }
             default:
                 return {}; // Unsupported column for WorldBank dataset
         }
@@ -508,6 +982,8 @@ RecordViews VectorDataSource::findByRange(Column col, const std::string& loS, co
 std::optional<RecordView> VectorDataSource::findMin() {
     if (dataset_ == Dataset::Fire) {
         if (fire_records_.empty()) return std::nullopt;
+        if (value_tree_.size()) return fire_to_view(fire_records_[*value_tree_.firstRow()]);
+        if (value_eytz_.size()) return fire_to_view(fire_records_[*value_eytz_.firstRow()]);
         auto it = std::min_element(fire_records_.begin(), fire_records_.end(),
             [](const FireRecord& a, const FireRecord& b) { return a.numericValue < b.numericValue; });
         return fire_to_view(*it);
@@ -522,6 +998,8 @@ std::optional<RecordView> VectorDataSource::findMin() {
 std::optional<RecordView> VectorDataSource::findMax() {
     if (dataset_ == Dataset::Fire) {
         if (fire_records_.empty()) return std::nullopt;
+        if (value_tree_.size()) return fire_to_view(fire_records_[*value_tree_.lastRow()]);
+        if (value_eytz_.size()) return fire_to_view(fire_records_[*value_eytz_.lastRow()]);
         auto it = std::max_element(fire_records_.begin(), fire_records_.end(),
             [](const FireRecord& a, const FireRecord& b) { return a.numericValue < b.numericValue; });
         return fire_to_view(*it);
@@ -546,81 +1024,3 @@ double VectorDataSource::sumByYear(int year) {
     }
     return sum;
 }
-
-void VectorDataSource::merge_dictionaries(const std::vector<Dictionaries>& threadDicts) {
-    // Merge all thread-local dictionaries into the main dictionaries_
-    for (const auto& threadDict : threadDicts) {
-        // Merge parameter_dict
-        for (const auto& [key, id] : threadDict.parameter_dict) {
-            if (dictionaries_.parameter_dict.find(key) == dictionaries_.parameter_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.parameter_dict.size();
-                dictionaries_.parameter_dict[key] = newId;
-                dictionaries_.parameter_names.push_back(key);
-            }
-        }
-        
-        // Merge unit_dict
-        for (const auto& [key, id] : threadDict.unit_dict) {
-            if (dictionaries_.unit_dict.find(key) == dictionaries_.unit_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.unit_dict.size();
-                dictionaries_.unit_dict[key] = newId;
-                dictionaries_.unit_names.push_back(key);
-            }
-        }
-        
-        // Merge site_dict
-        for (const auto& [key, id] : threadDict.site_dict) {
-            if (dictionaries_.site_dict.find(key) == dictionaries_.site_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.site_dict.size();
-                dictionaries_.site_dict[key] = newId;
-                dictionaries_.site_names.push_back(key);
-            }
-        }
-        
-        // Merge agency_dict
-        for (const auto& [key, id] : threadDict.agency_dict) {
-            if (dictionaries_.agency_dict.find(key) == dictionaries_.agency_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.agency_dict.size();
-                dictionaries_.agency_dict[key] = newId;
-                dictionaries_.agency_names.push_back(key);
-            }
-        }
-        
-        // Merge aqs_dict
-        for (const auto& [key, id] : threadDict.aqs_dict) {
-            if (dictionaries_.aqs_dict.find(key) == dictionaries_.aqs_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.aqs_dict.size();
-                dictionaries_.aqs_dict[key] = newId;
-                dictionaries_.aqs_names.push_back(key);
-            }
-        }
-        
-        // Merge country_name_dict
-        for (const auto& [key, id] : threadDict.country_name_dict) {
-            if (dictionaries_.country_name_dict.find(key) == dictionaries_.country_name_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.country_name_dict.size();
-                dictionaries_.country_name_dict[key] = newId;
-                dictionaries_.country_names.push_back(key);
-            }
-        }
-        
-        // Merge country_code_dict
-        for (const auto& [key, id] : threadDict.country_code_dict) {
-            if (dictionaries_.country_code_dict.find(key) == dictionaries_.country_code_dict.end()) {
-                uint32_t newId = (uint32_t)dictionaries_.country_code_dict.size();
-                dictionaries_.country_code_dict[key] = newId;
-                dictionaries_.country_codes.push_back(key);
-            }
-        }
-        
-        // Merge indicator_dict
-        for (const auto& [key, id] : threadDict.indicator_dict) {
-            if (dictionaries_.indicator_dict.find(key) == dictionaries_.indicator_dict.end()) {
-                uint16_t newId = (uint16_t)dictionaries_.indicator_dict.size();
-                dictionaries_.indicator_dict[key] = newId;
-                dictionaries_.indicator_names.push_back(key);
-            }
-        }
-    }
-}
-
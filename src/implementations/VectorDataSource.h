@@ -1,13 +1,37 @@
 #pragma once
 #include "../interfaces/IDataSource.h"
+#include "../interfaces/LoadOptions.h"
+#include "../index/BitSlicedIndex.h"
+#include "../index/BPlusTree.h"
+#include "../index/CrackerIndex.h"
+#include "../index/EytzingerIndex.h"
+#include "../index/IdwInterpolator.h"
+#include "../index/PointIndex.h"
+#include "../index/PolygonFilter.h"
+#include "../index/SegmentBloom.h"
+#include "../index/SiteIndex.h"
+#include "../index/SpatioTemporalIndex.h"
+#include "../index/TilePyramid.h"
+#include "../index/ZoneMap.h"
+#include "../utility/LoadPlanner.h"
+#include "../utility/Metrics.h"
 #include "../utility/Records.h"
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <unordered_map>
 
+// A monitor near a query point and its newest readings.
+struct NearbySite {
+    uint32_t site_id = 0;
+    double distance_km = 0.0;
+    RecordViews latest;
+};
+
 class VectorDataSource : public IDataSource {
 public:
-    explicit VectorDataSource(const std::string& filePath);
+    explicit VectorDataSource(const std::string& filePath, const LoadOptions& options = {});
 
     // Column-aware API (all scans)
     RecordViews findByRange(Column col, const std::string& minVal, const std::string& maxVal) override;
@@ -17,30 +41,118 @@ public:
     std::optional<RecordView> findMax() override;
     double sumByYear(int year) override;
 
+    // Query-argument parsing (false when empty or malformed); RawDataSource shares it
+    static bool to_ll(const std::string& s, long long& out);
+    static bool to_int(const std::string& s, int& out);
+    static bool to_double(const std::string& s, double& out);
+
+    // Read-only access for index builders and micro-benchmarks
+    const FireRecords& fireRecords() const { return fire_records_; }
+    const WorldBankRecords& worldBankRecords() const { return worldbank_records_; }
+    const Dictionaries& dictionaries() const { return dictionaries_; }
+    const SiteTable& sites() const { return dictionaries_.sites; }   // Fire site dimension
+
+    // Per-block min/max of the fire columns (Fire), used to skip blocks in scans
+    const ZoneMap& zoneMap() const { return zones_; }
+
+    // Per-hour Bloom filters on site, AQS and agency ids (Fire)
+    const SegmentBloom& segmentBloom() const { return segment_bloom_; }
+
+    // Heatmap tiles (LoadOptions::heatmap), nullptr when not built
+    const TilePyramid* heatmap() const { return heatmap_.get(); }
+
+    // Distinct sites with per-site rows and a k-d tree (Fire); built on first use
+    const SiteIndex& siteIndex() const;
+
+    // k closest monitors to (lat, lon) by great-circle distance, nearest first
+    std::vector<NearbySite> kNearestSites(double lat, double lon, size_t k) const;
+
+    // Readings within radiusKm of (lat, lon) during [utcFrom, utcTo] minutes,
+    // via a time-partitioned grid built on first use (Fire)
+    RecordViews findNear(double lat, double lon, double radiusKm, int32_t utcFrom, int32_t utcTo) const;
+
+    // Readings of one site (site dimension row) and parameter in the UTC hour
+    // holding utcMinutes, via a hash index built at load
+    // (LoadOptions::pointIndex) or on first use (Fire)
+    RecordViews lookup(uint32_t siteId, uint16_t parameterId, int32_t utcMinutes) const;
+    // The first reading of each key, nullopt where there is none
+    std::vector<std::optional<RecordView>> lookupBatch(const std::vector<PointIndex::Key>& keys) const;
+    const PointIndex& pointIndex() const;
+
+    // Readings whose latitude/longitude fall inside the geofence (Fire)
+    RecordViews findWithin(const PolygonFilter& fence) const;
+
+    // IDW surface of a parameter's per-site means over [utcFrom, utcTo) (Fire)
+    Raster interpolateIdw(uint16_t parameterId, int32_t utcFrom, int32_t utcTo,
+                          const GridSpec& grid, const IdwOptions& options = {}) const;
+
 private:
     enum class Dataset { Fire, WorldBank };
     Dataset dataset_{Dataset::WorldBank};
+    LoadOptions options_;
 
     // Dataset-specific storage
     FireRecords fire_records_;
     WorldBankRecords worldbank_records_;
     Dictionaries dictionaries_;
 
-    // Helper functions
-    static bool to_ll(const std::string& s, long long& out);
-    static bool to_int(const std::string& s, int& out);
-    static bool to_double(const std::string& s, double& out);
-    
+    // Rows are sorted by LoadOptions::clustering once loaded, before anything
+    // refers to row positions; zone maps are built on the final order.
+    ZoneMap zones_;
+    void reorganize();
+    template <typename Fn>
+    void scan_zones(ZoneMap::Field field, double lo, double hi, Fn fn) const;
+    SegmentBloom segment_bloom_;
+    template <typename Fn>
+    void scan_segments(SegmentBloom::Key key, long long lo, long long hi, Fn fn) const;
+
+    // Optional ordered indexes (Fire), key -> row in fire_records_. At most
+    // one family is built; empty ones mean "scan" (cracking indexes fill in
+    // on first query). Records never move after load.
+    BPlusTree<double> value_tree_;
+    BPlusTree<int32_t> utc_tree_;
+    BPlusTree<int32_t> aqi_tree_;
+    EytzingerIndex<double> value_eytz_;
+    EytzingerIndex<int32_t> utc_eytz_;
+    EytzingerIndex<int32_t> aqi_eytz_;
+    CrackerIndex<double> value_crack_;
+    CrackerIndex<int32_t> utc_crack_;
+    CrackerIndex<int32_t> aqi_crack_;
+    BitSlicedIndex value_bsi_;
+    BitSlicedIndex raw_bsi_;
+    void build_ordered_indexes();
+
+    std::unique_ptr<TilePyramid> heatmap_;
+
+    mutable std::once_flag site_index_once_;
+    mutable SiteIndex site_index_;
+    mutable std::once_flag near_index_once_;
+    mutable SpatioTemporalIndex near_index_;
+    mutable std::once_flag point_index_once_;
+    mutable PointIndex point_index_;
+
     // Loading functions
     void load_fire_data(const std::string& filePath);
     void load_worldbank_data(const std::string& filePath);
+    void load_directory(const std::vector<LoadTask>& files);
+    void finalize_dictionaries();
+
+    // Parse one task straight into out[0, capacity); returns rows written.
+    size_t parse_fire_file(const LoadTask& task, FireRecord* out, size_t capacity, Dictionaries& dicts);
+    size_t parse_worldbank_file(const LoadTask& task, WorldBankRecord* out, size_t capacity, Dictionaries& dicts);
+    static size_t estimate_fire_rows(const std::string& filePath);
+    static size_t estimate_worldbank_rows(const std::string& filePath);
     
     // Conversion functions
     RecordView fire_to_view(const FireRecord& record) const;
     RecordView worldbank_to_view(const WorldBankRecord& record) const;
     
-    // Dictionary helpers
-    uint32_t dict_get_or_add(std::unordered_map<std::string, uint32_t>& dict, const std::string& key);
-    uint16_t dict_get_or_add(std::unordered_map<std::string, uint16_t>& dict, const std::string& key);
+    // Fire helpers
     long long parse_utc_minutes(const std::string& utc);
+
+    // Metrics: per-file ingest counters and post-load gauges
+    // newestUtc: newest utc_minutes of the task's rows (Fire), for live ingest lag
+    void record_file_ingested(size_t rows, size_t files, int32_t newestUtc = INT32_MIN) const;
+    void publish_load_metrics() const;
+    mutable IngestLag ingest_lag_;
 };
@@ -0,0 +1,219 @@
+#pragma once
+#include "../utility/Interleave.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bptree_detail {
+
+// Number of keys[i] < key in a fixed-size node padded with max(). SSE2
+// compares 4 (or 2) keys per instruction with no data-dependent branches;
+// other key types fall back to a loop the compiler can vectorise.
+template <int N, typename K>
+inline int count_less(const K* keys, K key) {
+    int c = 0, i = 0;
+#if defined(__SSE2__)
+    if constexpr (std::is_same<K, int32_t>::value) {
+        const __m128i k = _mm_set1_epi32(key);
+        for (; i + 4 <= N; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+            c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, k))));
+        }
+    } else if constexpr (std::is_same<K, float>::value) {
+        const __m128 k = _mm_set1_ps(key);
+        for (; i + 4 <= N; i += 4) {
+            c += __builtin_popcount(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(keys + i), k)));
+        }
+    } else if constexpr (std::is_same<K, double>::value) {
+        const __m128d k = _mm_set1_pd(key);
+        for (; i + 2 <= N; i += 2) {
+            c += __builtin_popcount(_mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(keys + i), k)));
+        }
+    }
+#endif
+    for (; i < N; ++i) c += keys[i] < key;
+    return c;
+}
+
+} // namespace bptree_detail
+
+// Read-only, bulk-loaded B+tree mapping key -> row id (duplicates allowed).
+// Nodes are two cache lines. Children of an inner node are contiguous in the
+// level below, so inner nodes store only separator keys and the first child
+// index; leaves store (key, row) pairs plus a link to the next leaf.
+template <typename K>
+class BPlusTree {
+public:
+    static constexpr size_t kNodeBytes = 128;
+    static constexpr int kInnerKeys = (int)((kNodeBytes - 2 * sizeof(uint32_t)) / sizeof(K));
+    static constexpr int kFanout    = kInnerKeys + 1;
+    static constexpr int kLeafKeys  = (int)((kNodeBytes - 2 * sizeof(uint32_t)) / (sizeof(K) + sizeof(uint32_t)));
+
+    // sorted must be ordered by key; rows with equal keys keep their order.
+    void bulkLoad(const std::vector<std::pair<K, uint32_t>>& sorted) {
+        leaves_.clear();
+        levels_.clear();
+        size_ = sorted.size();
+        if (sorted.empty()) return;
+
+        // Leaves are packed full: the tree is never updated after load
+        const size_t nLeaves = (sorted.size() + kLeafKeys - 1) / kLeafKeys;
+        leaves_.resize(nLeaves);
+        for (size_t l = 0; l < nLeaves; ++l) {
+            Leaf& leaf = leaves_[l];
+            const size_t base = l * kLeafKeys;
+            leaf.count = (uint32_t)std::min<size_t>(kLeafKeys, sorted.size() - base);
+            for (int i = 0; i < kLeafKeys; ++i) {
+                bool used = i < (int)leaf.count;
+                leaf.keys[i] = used ? sorted[base + i].first : pad();
+                leaf.rows[i] = used ? sorted[base + i].second : 0;
+            }
+            leaf.next = l + 1 < nLeaves ? (uint32_t)(l + 1) : kNone;
+        }
+
+        // Inner levels bottom-up; separator i is the smallest key under child i+1
+        std::vector<K> childMin(nLeaves);
+        for (size_t l = 0; l < nLeaves; ++l) childMin[l] = leaves_[l].keys[0];
+        size_t children = nLeaves;
+        while (children > 1) {
+            const size_t nNodes = (children + kFanout - 1) / kFanout;
+            std::vector<Inner> level(nNodes);
+            std::vector<K> nextMin(nNodes);
+            for (size_t n = 0; n < nNodes; ++n) {
+                Inner& node = level[n];
+                const size_t first = n * kFanout;
+                node.first_child = (uint32_t)first;
+                node.count = (uint32_t)std::min<size_t>(kFanout, children - first);
+                for (int i = 0; i < kInnerKeys; ++i) {
+                    node.keys[i] = i + 1 < (int)node.count ? childMin[first + i + 1] : pad();
+                }
+                nextMin[n] = childMin[first];
+            }
+            levels_.push_back(std::move(level));
+            childMin = std::move(nextMin);
+            children = nNodes;
+        }
+    }
+
+    // Visit (key, row) for lo <= key <= hi in key order. A visitor that
+    // returns bool stops the scan by returning false.
+    template <typename Fn>
+    void scan(K lo, K hi, Fn&& visit) const {
+        if (size_ == 0 || !(lo <= hi)) return;   // also NaN bounds
+        uint32_t leaf = find_leaf(lo);
+        int i = (int)leaf_pos(leaves_[leaf], lo);
+        for (; leaf != kNone; leaf = leaves_[leaf].next, i = 0) {
+            const Leaf& l = leaves_[leaf];
+            for (; i < (int)l.count; ++i) {
+                if (hi < l.keys[i]) return;
+                if constexpr (std::is_same<decltype(visit(l.keys[i], l.rows[i])), bool>::value) {
+                    if (!visit(l.keys[i], l.rows[i])) return;
+                } else {
+                    visit(l.keys[i], l.rows[i]);
+                }
+            }
+        }
+    }
+
+    // Position of the first key >= key in tree order (size() if none).
+    size_t lowerBound(K key) const {
+        if (size_ == 0) return 0;
+        uint32_t leaf = find_leaf(key);
+        return (size_t)leaf * kLeafKeys + leaf_pos(leaves_[leaf], key);
+    }
+
+    // out[i] = lowerBound(keys[i]) with `group` descents (1..kMaxInterleave)
+    // interleaved: each prefetches its next node and yields to the others
+    // before reading it, so the misses of different descents overlap.
+    void lowerBoundBatch(const K* keys, size_t n, size_t* out, size_t group = 16) const {
+        if (size_ == 0) {
+            std::fill(out, out + n, 0);
+            return;
+        }
+        // One descent: the node to read next, levels_.size()..1 inner, 0 leaf
+        struct State { size_t i; size_t level; uint32_t node; };
+        interleave_lookups<State>(n, group,
+            [&](size_t i, State& st) {
+                st = {i, levels_.size(), 0};
+                prefetch_node(st.level, st.node);
+            },
+            [&](State& st) {
+                if (st.level == 0) {
+                    out[st.i] = (size_t)st.node * kLeafKeys + leaf_pos(leaves_[st.node], keys[st.i]);
+                    return true;
+                }
+                st.node = child_of(levels_[st.level - 1][st.node], keys[st.i]);
+                prefetch_node(--st.level, st.node);
+                return false;
+            });
+    }
+
+    // Row with the smallest / largest key, nullptr when empty.
+    const uint32_t* firstRow() const { return size_ ? &leaves_.front().rows[0] : nullptr; }
+    const uint32_t* lastRow() const { return size_ ? &leaves_.back().rows[leaves_.back().count - 1] : nullptr; }
+
+    size_t size() const { return size_; }
+    size_t memoryBytes() const {
+        size_t bytes = leaves_.capacity() * sizeof(Leaf);
+        for (const auto& level : levels_) bytes += level.capacity() * sizeof(Inner);
+        return bytes;
+    }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct alignas(64) Inner {
+        K keys[kInnerKeys];
+        uint32_t first_child;   // children: first_child .. first_child + count - 1
+        uint32_t count;
+    };
+    struct alignas(64) Leaf {
+        K keys[kLeafKeys];
+        uint32_t rows[kLeafKeys];
+        uint32_t count;
+        uint32_t next;
+    };
+    static_assert(sizeof(Inner) == kNodeBytes && sizeof(Leaf) == kNodeBytes, "node must be two cache lines");
+
+    static K pad() { return std::numeric_limits<K>::max(); }
+
+    // Leftmost leaf whose range can hold the first key >= key. Separators are
+    // compared with <, so runs of duplicates are entered at their start.
+    uint32_t find_leaf(K key) const {
+        uint32_t node = 0;
+        for (size_t lv = levels_.size(); lv-- > 0;) {
+            node = child_of(levels_[lv][node], key);
+        }
+        return node;
+    }
+
+    // A key above max() (+inf) also counts the padding, so both positions
+    // are clamped to the node's real entries.
+    static uint32_t child_of(const Inner& in, K key) {
+        uint32_t c = (uint32_t)bptree_detail::count_less<kInnerKeys>(in.keys, key);
+        return in.first_child + std::min(c, in.count - 1);
+    }
+    static uint32_t leaf_pos(const Leaf& l, K key) {
+        return std::min((uint32_t)bptree_detail::count_less<kLeafKeys>(l.keys, key), l.count);
+    }
+
+    // Both cache lines of a node; level 0 is the leaves, level l > 0 is levels_[l - 1]
+    void prefetch_node(size_t level, uint32_t node) const {
+        const char* p = level ? reinterpret_cast<const char*>(&levels_[level - 1][node])
+                              : reinterpret_cast<const char*>(&leaves_[node]);
+        __builtin_prefetch(p);
+        __builtin_prefetch(p + 64);
+    }
+
+    std::vector<Leaf> leaves_;
+    std::vector<std::vector<Inner>> levels_;   // levels_[0] sits above the leaves; back() is the root
+    size_t size_ = 0;
+};
@@ -0,0 +1,78 @@
+#include "index/BitSlicedIndex.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <cmath>
+
+void BitSlicedIndex::build(const std::vector<double>& values) {
+    rows_ = values.size();
+    blocks_ = (rows_ + kBlockRows - 1) / kBlockRows;
+
+    dictionary_.clear();
+    for (double v : values) if (!std::isnan(v)) dictionary_.push_back(v);
+    parallel_radix_sort(dictionary_, [](double v) { return v; });
+    dictionary_.erase(std::unique(dictionary_.begin(), dictionary_.end()), dictionary_.end());
+    dictionary_.shrink_to_fit();
+    bits_ = 1;
+    while (bits_ < 32 && (size_t(1) << bits_) < dictionary_.size()) ++bits_;
+
+    slices_.assign(blocks_ * bits_ * kBlockWords, 0);
+    present_.assign(blocks_ * kBlockWords, 0);
+    #pragma omp parallel for schedule(static)
+    for (long long block = 0; block < (long long)blocks_; ++block) {
+        uint64_t* base = slices_.data() + (size_t)block * bits_ * kBlockWords;
+        const size_t begin = (size_t)block * kBlockRows, end = std::min(rows_, begin + kBlockRows);
+        for (size_t r = begin; r < end; ++r) {
+            if (std::isnan(values[r])) continue;
+            const size_t word = (r - begin) / 64;
+            const uint64_t bit = uint64_t(1) << (r % 64);
+            present_[r / 64] |= bit;
+            const uint32_t code = (uint32_t)(std::lower_bound(dictionary_.begin(), dictionary_.end(), values[r]) - dictionary_.begin());
+            for (unsigned b = 0; b < bits_; ++b) {
+                if ((code >> b) & 1) base[b * kBlockWords + word] |= bit;
+            }
+        }
+    }
+}
+
+std::vector<uint64_t> BitSlicedIndex::select(double lo, double hi) const {
+    std::vector<uint64_t> out(blocks_ * kBlockWords, 0);
+    if (dictionary_.empty() || !(lo <= hi)) return out;
+    // Codes [first, last] cover the values in [lo, hi]
+    const size_t first = (size_t)(std::lower_bound(dictionary_.begin(), dictionary_.end(), lo) - dictionary_.begin());
+    const size_t upper = (size_t)(std::upper_bound(dictionary_.begin(), dictionary_.end(), hi) - dictionary_.begin());
+    if (first >= upper) return out;
+    const uint64_t loCode = first, hiCode = upper - 1;
+
+    #pragma omp parallel for schedule(static)
+    for (long long block = 0; block < (long long)blocks_; ++block) {
+        // Per row: greater than / equal so far to loCode, less than / equal to hiCode
+        uint64_t gt[kBlockWords], eqLo[kBlockWords], lt[kBlockWords], eqHi[kBlockWords];
+        for (size_t j = 0; j < kBlockWords; ++j) { gt[j] = 0; lt[j] = 0; eqLo[j] = ~uint64_t(0); eqHi[j] = ~uint64_t(0); }
+
+        for (int b = (int)bits_ - 1; b >= 0; --b) {
+            const uint64_t* s = slice((size_t)block, (unsigned)b);
+            const uint64_t mLo = ((loCode >> b) & 1) ? ~uint64_t(0) : 0;
+            const uint64_t mHi = ((hiCode >> b) & 1) ? ~uint64_t(0) : 0;
+            uint64_t open = 0;
+            #pragma omp simd reduction(|:open)
+            for (size_t j = 0; j < kBlockWords; ++j) {
+                gt[j] |= eqLo[j] & s[j] & ~mLo;
+                eqLo[j] &= ~(s[j] ^ mLo);
+                lt[j] |= eqHi[j] & ~s[j] & mHi;
+                eqHi[j] &= ~(s[j] ^ mHi);
+                open |= eqLo[j] | eqHi[j];
+            }
+            if (!open) break;   // every row already decided
+        }
+
+        uint64_t* dst = out.data() + (size_t)block * kBlockWords;
+        const uint64_t* present = present_.data() + (size_t)block * kBlockWords;
+        for (size_t j = 0; j < kBlockWords; ++j) dst[j] = (gt[j] | eqLo[j]) & (lt[j] | eqHi[j]) & present[j];
+    }
+    return out;
+}
+
+size_t BitSlicedIndex::memoryBytes() const {
+    return (slices_.capacity() + present_.capacity()) * sizeof(uint64_t) + dictionary_.capacity() * sizeof(double);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bit-sliced index over one numeric column. Values are encoded as their
+// rank among the column's distinct values (an order-preserving dictionary,
+// so predicates stay exact), and code bit b of every row is stored as its
+// own bitmap "slice". A range predicate walks the slices from the top bit
+// down, keeping per-row "less" and "equal" words, 64 rows per word; rows
+// of a block are done as soon as no row is still equal to a bound.
+//
+// Layout: blocks of kBlockRows rows; inside a block each slice is
+// kBlockWords contiguous words, so the per-slice step is a simd loop.
+class BitSlicedIndex {
+public:
+    static constexpr size_t kBlockWords = 64;
+    static constexpr size_t kBlockRows = kBlockWords * 64;
+
+    // NaN marks a missing value; it never matches.
+    void build(const std::vector<double>& values);
+
+    // Bitmap of rows with lo <= value <= hi (bit r % 64 of word r / 64).
+    // Blocks run in parallel.
+    std::vector<uint64_t> select(double lo, double hi) const;
+
+    // Rows of a bitmap from select(), ascending.
+    template <typename Fn>
+    static void forEachRow(const std::vector<uint64_t>& bitmap, Fn&& visit) {
+        for (size_t w = 0; w < bitmap.size(); ++w) {
+            for (uint64_t bits = bitmap[w]; bits; bits &= bits - 1) {
+                visit((uint32_t)(w * 64 + (size_t)__builtin_ctzll(bits)));
+            }
+        }
+    }
+
+    size_t size() const { return rows_; }
+    unsigned bits() const { return bits_; }
+    size_t distinct() const { return dictionary_.size(); }
+    size_t memoryBytes() const;
+
+private:
+    // Slice b of a block: slices_[(block * bits_ + b) * kBlockWords ...]
+    const uint64_t* slice(size_t block, unsigned b) const {
+        return slices_.data() + (block * bits_ + b) * kBlockWords;
+    }
+
+    size_t rows_ = 0;
+    size_t blocks_ = 0;
+    unsigned bits_ = 0;
+    std::vector<double> dictionary_;        // sorted distinct values; code = position
+    std::vector<uint64_t> slices_;
+    std::vector<uint64_t> present_;         // rows with a value (not NaN)
+};
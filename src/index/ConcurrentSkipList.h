@@ -0,0 +1,177 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+
+// Composite index key: column value with the row id as tie-breaker, so
+// duplicate column values stay distinct and ordered by row.
+template <typename K>
+struct RowKey {
+    K value{};
+    uint32_t row = 0;
+
+    friend bool operator<(const RowKey& a, const RowKey& b) {
+        return a.value < b.value || (!(b.value < a.value) && a.row < b.row);
+    }
+    // False whenever either value is unordered (NaN), unlike !(b < a)
+    friend bool operator<=(const RowKey& a, const RowKey& b) {
+        return a.value < b.value || (a.value == b.value && a.row <= b.row);
+    }
+};
+
+// Lock-free, insert-only skip list (Fraser/Herlihy style without deletion).
+// Concurrent insert() and scan()/find from any number of threads; nodes are
+// published with a release CAS on level 0 and then linked upwards. Without
+// removal there is no reclamation problem: nodes live until destruction.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class ConcurrentSkipList {
+public:
+    static constexpr int kMaxLevel = 24;
+
+    ConcurrentSkipList() : head_(make_node(Key{}, Value{}, kMaxLevel)) {}
+    ~ConcurrentSkipList() {
+        Node* n = head_;
+        while (n) { Node* next = n->next(0).load(std::memory_order_relaxed); free_node(n); n = next; }
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    // Returns false if an equal key is already present.
+    bool insert(const Key& key, const Value& value) {
+        Node* preds[kMaxLevel];
+        Node* succs[kMaxLevel];
+        const int height = random_height();
+        Node* node = nullptr;
+
+        for (;;) {
+            find(key, preds, succs);
+            if (succs[0] && !cmp_(key, succs[0]->key)) {
+                if (node) free_node(node);
+                return false;
+            }
+            if (!node) node = make_node(key, value, height);
+            for (int l = 0; l < height; ++l) node->next(l).store(succs[l], std::memory_order_relaxed);
+
+            Node* expected = succs[0];
+            if (preds[0]->next(0).compare_exchange_strong(expected, node,
+                    std::memory_order_release, std::memory_order_relaxed)) break;
+        }
+
+        // Visible from here on; link the upper levels, re-searching on conflict.
+        for (int l = 1; l < height; ++l) {
+            for (;;) {
+                Node* expected = succs[l];
+                if (preds[l]->next(l).compare_exchange_strong(expected, node,
+                        std::memory_order_release, std::memory_order_relaxed)) break;
+                find(key, preds, succs);
+                node->next(l).store(succs[l], std::memory_order_relaxed);
+            }
+        }
+
+        int top = level_.load(std::memory_order_relaxed);
+        while (top < height && !level_.compare_exchange_weak(top, height, std::memory_order_relaxed)) {}
+        size_.fetch_add(1, std::memory_order_relaxed);
+        links_.fetch_add((size_t)height, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Visit every (key, value) with lo <= key <= hi in key order.
+    template <typename Fn>
+    void scan(const Key& lo, const Key& hi, Fn&& visit) const {
+        if (!(lo <= hi)) return;   // also NaN bounds
+        for (Node* n = lower_bound(lo); n && !cmp_(hi, n->key); n = n->next(0).load(std::memory_order_acquire)) {
+            visit(n->key, n->value);
+        }
+    }
+
+    const Value* first() const {
+        Node* n = head_->next(0).load(std::memory_order_acquire);
+        return n ? &n->value : nullptr;
+    }
+
+    const Value* last() const {
+        Node* x = head_;
+        for (int l = level_.load(std::memory_order_acquire) - 1; l >= 0; --l) {
+            for (Node* nx = x->next(l).load(std::memory_order_acquire); nx; nx = x->next(l).load(std::memory_order_acquire)) {
+                x = nx;
+            }
+        }
+        return x == head_ ? nullptr : &x->value;
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    // Nodes (head included) plus the tower pointers past each one's first.
+    size_t memoryBytes() const {
+        const size_t nodes = size() + 1;
+        const size_t links = links_.load(std::memory_order_relaxed) + kMaxLevel;
+        return nodes * sizeof(Node) + (links - nodes) * sizeof(std::atomic<Node*>);
+    }
+
+private:
+    struct Node {
+        Key key;
+        Value value;
+        int height;
+        std::atomic<Node*> tower[1];   // over-allocated to `height` entries
+
+        std::atomic<Node*>& next(int l) { return tower[l]; }
+        const std::atomic<Node*>& next(int l) const { return tower[l]; }
+    };
+
+    static Node* make_node(const Key& key, const Value& value, int height) {
+        size_t bytes = sizeof(Node) + (size_t)(height - 1) * sizeof(std::atomic<Node*>);
+        void* mem = ::operator new(bytes);
+        Node* n = static_cast<Node*>(mem);
+        new (&n->key) Key(key);
+        new (&n->value) Value(value);
+        n->height = height;
+        for (int l = 0; l < height; ++l) new (&n->tower[l]) std::atomic<Node*>(nullptr);
+        return n;
+    }
+
+    static void free_node(Node* n) {
+        n->key.~Key();
+        n->value.~Value();
+        ::operator delete(n);
+    }
+
+    static int random_height() {
+        // xorshift per thread; p = 1/4 per extra level
+        thread_local uint64_t state = 0x9E3779B97F4A7C15ull ^ (uint64_t)(uintptr_t)&state;
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        uint64_t bits = state;
+        int h = 1;
+        while (h < kMaxLevel && (bits & 3) == 0) { ++h; bits >>= 2; }
+        return h;
+    }
+
+    // preds[l] is the last node < key at level l, succs[l] its successor.
+    void find(const Key& key, Node** preds, Node** succs) const {
+        Node* x = head_;
+        for (int l = kMaxLevel - 1; l >= 0; --l) {
+            Node* nx = x->next(l).load(std::memory_order_acquire);
+            while (nx && cmp_(nx->key, key)) { x = nx; nx = x->next(l).load(std::memory_order_acquire); }
+            preds[l] = x;
+            succs[l] = nx;
+        }
+    }
+
+    Node* lower_bound(const Key& key) const {
+        Node* x = head_;
+        for (int l = level_.load(std::memory_order_acquire) - 1; l >= 0; --l) {
+            Node* nx = x->next(l).load(std::memory_order_acquire);
+            while (nx && cmp_(nx->key, key)) { x = nx; nx = x->next(l).load(std::memory_order_acquire); }
+        }
+        return x->next(0).load(std::memory_order_acquire);
+    }
+
+    Node* head_;
+    std::atomic<int> level_{1};
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> links_{0};   // sum of inserted node heights
+    Compare cmp_{};
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+// Adaptive index (database cracking) over one column. The first query
+// copies the column as (key, row) pairs; every query then partitions the
+// pieces holding its two bounds in place and records where each bound
+// split them. Later queries with known bounds only read, so repeated
+// ranges converge towards index speed with no upfront build.
+//
+// Thread safety: a reader-writer lock per column. Queries whose bounds are
+// both cracked already share the lock; a query that must crack takes it
+// exclusively, re-checks, partitions, and reads before releasing.
+template <typename K>
+class CrackerIndex {
+public:
+    // Rows with lo <= key <= hi, in the column's current (cracked) order:
+    // grouped by piece, unordered inside one. load() returns the (key, row)
+    // pairs to index; it runs once, on the first call.
+    template <typename Load>
+    std::vector<uint32_t> rows(K lo, K hi, Load load) {
+        std::call_once(loaded_, [&] { column_ = load(); });
+        std::vector<uint32_t> out;
+        // Unordered bounds (NaN) must never become map keys
+        if (!(lo <= hi) || column_.empty()) return out;
+        const Bound first{lo, false}, last{hi, true};
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto a = cracks_.find(first), b = cracks_.find(last);
+            if (a != cracks_.end() && b != cracks_.end()) {
+                collect(a->second, b->second, out);
+                return out;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        const size_t begin = crack(first), end = crack(last);
+        collect(begin, end, out);
+        return out;
+    }
+
+    // Pieces the column is split into (0 before the first query)
+    size_t pieces() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return column_.empty() ? 0 : cracks_.size() + 1;
+    }
+    size_t memoryBytes() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        // map node: key + position + three pointers and colour
+        return column_.capacity() * sizeof(std::pair<K, uint32_t>)
+             + cracks_.size() * (sizeof(Bound) + sizeof(size_t) + 4 * sizeof(void*));
+    }
+
+private:
+    // Split point: after=false puts keys < value left, after=true keys <= value
+    struct Bound {
+        K value;
+        bool after;
+        bool operator<(const Bound& o) const {
+            if (value < o.value) return true;
+            if (o.value < value) return false;
+            return after < o.after;
+        }
+    };
+
+    // Partition the piece holding b (exclusive lock held); returns its position
+    size_t crack(const Bound& b) {
+        auto hit = cracks_.find(b);
+        if (hit != cracks_.end()) return hit->second;
+        auto next = cracks_.upper_bound(b);
+        const size_t end = next == cracks_.end() ? column_.size() : next->second;
+        const size_t begin = next == cracks_.begin() ? 0 : std::prev(next)->second;
+        auto mid = std::partition(column_.begin() + begin, column_.begin() + end,
+            [&](const std::pair<K, uint32_t>& e) { return b.after ? !(b.value < e.first) : e.first < b.value; });
+        const size_t pos = (size_t)(mid - column_.begin());
+        cracks_.emplace_hint(next, b, pos);
+        return pos;
+    }
+
+    void collect(size_t begin, size_t end, std::vector<uint32_t>& out) const {
+        if (end <= begin) return;
+        out.resize(end - begin);
+        for (size_t i = begin; i < end; ++i) out[i - begin] = column_[i].second;
+    }
+
+    std::once_flag loaded_;
+    mutable std::shared_mutex mutex_;
+    std::vector<std::pair<K, uint32_t>> column_;
+    std::map<Bound, size_t> cracks_;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Static sorted-key index in Eytzinger (BFS) order: node k has children 2k
+// and 2k+1, so the first levels of every search share a few cache lines and
+// the descent can prefetch 4 levels ahead. Descent is branchless; the final
+// node is recovered from the path bits. rows_ keeps the sorted row order,
+// so a [lower, upper) bound pair is a contiguous run of it.
+template <typename K>
+class EytzingerIndex {
+public:
+    // sorted must be ordered by key; rows with equal keys keep their order.
+    void bulkLoad(const std::vector<std::pair<K, uint32_t>>& sorted) {
+        const size_t n = sorted.size();
+        keys_.assign(n + 1, K{});
+        rank_.assign(n + 1, (uint32_t)n);
+        rows_.resize(n);
+        for (size_t i = 0; i < n; ++i) rows_[i] = sorted[i].second;
+        size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    // Sorted position of the first key >= key / > key (size() if none).
+    size_t lowerBound(K key) const { return descend(key, [](K a, K b) { return a < b; }); }
+    size_t upperBound(K key) const { return descend(key, [](K a, K b) { return !(b < a); }); }
+
+    // Visit (key-ordered) rows with lo <= key <= hi.
+    template <typename Fn>
+    void scan(K lo, K hi, Fn&& visit) const {
+        if (!(lo <= hi)) return;   // also NaN bounds
+        const size_t end = upperBound(hi);
+        for (size_t i = lowerBound(lo); i < end; ++i) visit(rows_[i]);
+    }
+
+    const uint32_t* firstRow() const { return rows_.empty() ? nullptr : &rows_.front(); }
+    const uint32_t* lastRow() const { return rows_.empty() ? nullptr : &rows_.back(); }
+
+    size_t size() const { return rows_.size(); }
+    size_t memoryBytes() const {
+        return keys_.capacity() * sizeof(K) + (rank_.capacity() + rows_.capacity()) * sizeof(uint32_t);
+    }
+
+private:
+    // In-order walk of the implicit tree assigns sorted elements to BFS slots
+    void fill(const std::vector<std::pair<K, uint32_t>>& sorted, size_t& next, size_t k) {
+        if (k >= keys_.size()) return;
+        fill(sorted, next, 2 * k);
+        keys_[k] = sorted[next].first;
+        rank_[k] = (uint32_t)next++;
+        fill(sorted, next, 2 * k + 1);
+    }
+
+    template <typename Less>
+    size_t descend(K key, Less less) const {
+        const size_t n = keys_.size() - 1;
+        // One cache line holds kBlock keys: 4 levels below k start at k * kBlock
+        constexpr size_t kBlock = 64 / sizeof(K);
+        const char* base = reinterpret_cast<const char*>(keys_.data());
+        size_t k = 1;
+        while (k <= n) {
+            __builtin_prefetch(base + k * kBlock * sizeof(K));
+            k = 2 * k + (size_t)less(keys_[k], key);
+        }
+        // Undo the trailing right turns (plus one left turn) to reach the answer
+        k >>= __builtin_ffsll((long long)~k);
+        return rank_[k];   // rank_[0] == n: nothing qualifies
+    }
+
+    std::vector<K> keys_;          // 1-based Eytzinger order, slot 0 unused
+    std::vector<uint32_t> rank_;   // sorted position of each slot
+    std::vector<uint32_t> rows_;   // row ids in key order
+};
@@ -0,0 +1,199 @@
+#include "index/IdwInterpolator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+// Cells per tile: one candidate list per tile, simd across a tile row
+static constexpr uint32_t kTileRows = 8;
+static constexpr uint32_t kTileCols = 32;
+
+// Floor on squared chord length (~0.6 mm) so a cell on a site takes its value
+static constexpr double kMinChord2 = 1e-20;
+
+IdwInterpolator::Reporting IdwInterpolator::site_means(uint16_t parameterId, int32_t utcFrom, int32_t utcTo) const {
+    const auto& sites = sites_.sites();
+    const long long n = (long long)sites.size();
+    std::vector<double> sum((size_t)n, 0.0);
+    std::vector<uint32_t> count((size_t)n, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long s = 0; s < n; ++s) {
+        // Per-site rows are time-ordered: seek to the bucket, read to its end
+        const uint32_t* end = sites_.rowsEnd(sites[s]);
+        const uint32_t* it = std::lower_bound(sites_.rowsBegin(sites[s]), end, utcFrom,
+            [&](uint32_t row, int32_t t) { return records_[row].utc_minutes < t; });
+        for (; it != end && records_[*it].utc_minutes < utcTo; ++it) {
+            const FireRecord& r = records_[*it];
+            if (r.parameter_id != parameterId || std::isnan(r.value)) continue;
+            sum[s] += r.value;
+            ++count[s];
+        }
+    }
+
+    Reporting out;
+    for (long long s = 0; s < n; ++s) {
+        if (!count[s] || std::isnan(sites[s].latitude) || std::isnan(sites[s].longitude)) continue;
+        out.latitude.push_back(sites[s].latitude);
+        out.longitude.push_back(sites[s].longitude);
+        out.value.push_back((float)(sum[s] / count[s]));
+    }
+    return out;
+}
+
+Raster IdwInterpolator::interpolate(uint16_t parameterId, int32_t utcFrom, int32_t utcTo,
+                                    const GridSpec& grid, const IdwOptions& options) const {
+    Raster raster;
+    raster.grid = grid;
+    raster.utc_from = utcFrom;
+    raster.utc_to = utcTo;
+    if (!grid.rows || !grid.cols) return raster;
+    raster.values.assign(grid.cells(), std::numeric_limits<float>::quiet_NaN());
+
+    const Reporting rep = site_means(parameterId, utcFrom, utcTo);
+    raster.sites = rep.value.size();
+    if (rep.value.empty()) return raster;
+
+    // k-d tree over the reporting sites; tree slots line up with rep
+    SiteTable table(rep.value.size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i].latitude = rep.latitude[i];
+        table[i].longitude = rep.longitude[i];
+    }
+    SiteIndex tree;
+    tree.buildSites(table);
+
+    std::vector<double> sx(table.size()), sy(table.size()), sz(table.size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        const double la = rep.latitude[i] * kDegToRad, lo = rep.longitude[i] * kDegToRad;
+        sx[i] = std::cos(la) * std::cos(lo);
+        sy[i] = std::cos(la) * std::sin(lo);
+        sz[i] = std::sin(la);
+    }
+    std::vector<double> rowCos(grid.rows), rowSin(grid.rows), colCos(grid.cols), colSin(grid.cols);
+    for (uint32_t r = 0; r < grid.rows; ++r) {
+        rowCos[r] = std::cos(grid.cellLat(r) * kDegToRad);
+        rowSin[r] = std::sin(grid.cellLat(r) * kDegToRad);
+    }
+    for (uint32_t c = 0; c < grid.cols; ++c) {
+        colCos[c] = std::cos(grid.cellLon(c) * kDegToRad);
+        colSin[c] = std::sin(grid.cellLon(c) * kDegToRad);
+    }
+
+    const size_t k = std::min(std::max<size_t>(1, std::min(options.neighbors, kMaxNeighbors)), rep.value.size());
+    const bool inverseSquare = options.power == 2.0;
+    const double halfPower = options.power / 2.0;
+    // Squared chord of max_km; 4 (the diameter squared) keeps every real site
+    double maxChord2 = 4.0;
+    if (options.max_km > 0.0) {
+        const double c = 2.0 * std::sin(std::min(options.max_km / SiteIndex::kEarthRadiusKm / 2.0, 1.5707963267948966));
+        maxChord2 = c * c;
+    }
+
+    const uint32_t tilesY = (grid.rows + kTileRows - 1) / kTileRows;
+    const uint32_t tilesX = (grid.cols + kTileCols - 1) / kTileCols;
+    const long long tiles = (long long)tilesY * tilesX;
+    const float* value = rep.value.data();
+    float* out = raster.values.data();
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long t = 0; t < tiles; ++t) {
+        const uint32_t r0 = (uint32_t)(t / tilesX) * kTileRows, r1 = std::min(grid.rows, r0 + kTileRows);
+        const uint32_t c0 = (uint32_t)(t % tilesX) * kTileCols, c1 = std::min(grid.cols, c0 + kTileCols);
+        const uint32_t n = c1 - c0;
+
+        // Every cell is within h of the centre, so each cell's k nearest
+        // sites lie within d_k(centre) + 2h of the centre
+        const double cLat = (grid.cellLat(r0) + grid.cellLat(r1 - 1)) / 2.0;
+        const double cLon = (grid.cellLon(c0) + grid.cellLon(c1 - 1)) / 2.0;
+        double h = 0.0;
+        for (uint32_t r : {r0, r1 - 1})
+            for (uint32_t c : {c0, c1 - 1}) h = std::max(h, SiteIndex::haversineKm(cLat, cLon, grid.cellLat(r), grid.cellLon(c)));
+        h = h * (1.0 + 1e-9) + 1e-9;
+
+        std::vector<SiteIndex::Neighbor> nb;
+        double bound = 0.0;
+        for (size_t want = k;; want *= 2) {
+            nb = tree.nearest(cLat, cLon, want);
+            bound = nb[std::min(k, nb.size()) - 1].distance_km + 2.0 * h;
+            if (options.max_km > 0.0) bound = std::min(bound, options.max_km + h);
+            if (nb.size() < want || nb.back().distance_km > bound) break;
+        }
+        std::vector<uint32_t> candidates;
+        for (const auto& x : nb) if (x.distance_km <= bound) candidates.push_back(x.site);
+
+        double px[kTileCols], py[kTileCols], pz[kTileCols], d[kTileCols];
+        uint32_t id[kTileCols];
+        double best[kMaxNeighbors][kTileCols];
+        uint32_t bestId[kMaxNeighbors][kTileCols];
+
+        for (uint32_t r = r0; r < r1; ++r) {
+            for (uint32_t c = 0; c < n; ++c) {
+                px[c] = rowCos[r] * colCos[c0 + c];
+                py[c] = rowCos[r] * colSin[c0 + c];
+                pz[c] = rowSin[r];
+            }
+            for (size_t j = 0; j < k; ++j) {
+                std::fill(best[j], best[j] + n, std::numeric_limits<double>::infinity());
+                std::fill(bestId[j], bestId[j] + n, 0u);
+            }
+
+            // Per-cell sorted top-k: each candidate bubbles down the k slots,
+            // branch-free so the compiler can keep it in vector registers
+            for (uint32_t s : candidates) {
+                const double qx = sx[s], qy = sy[s], qz = sz[s];
+                #pragma omp simd
+                for (uint32_t c = 0; c < n; ++c) {
+                    const double dx = px[c] - qx, dy = py[c] - qy, dz = pz[c] - qz;
+                    d[c] = dx * dx + dy * dy + dz * dz;
+                    id[c] = s;
+                }
+                for (size_t j = 0; j < k; ++j) {
+                    double* bj = best[j];
+                    uint32_t* ij = bestId[j];
+                    #pragma omp simd
+                    for (uint32_t c = 0; c < n; ++c) {
+                        const double b = bj[c];
+                        const uint32_t bi = ij[c];
+                        const bool closer = d[c] < b;
+                        bj[c] = closer ? d[c] : b;
+                        ij[c] = closer ? id[c] : bi;
+                        d[c] = closer ? b : d[c];
+                        id[c] = closer ? bi : id[c];
+                    }
+                }
+            }
+
+            float* row = out + (size_t)r * grid.cols + c0;
+            #pragma omp simd
+            for (uint32_t c = 0; c < n; ++c) {
+                double sw = 0.0, swv = 0.0;
+                for (size_t j = 0; j < k; ++j) {
+                    const double d2 = std::max(best[j][c], kMinChord2);
+                    const double w = d2 > maxChord2 ? 0.0 : inverseSquare ? 1.0 / d2 : std::pow(d2, -halfPower);
+                    sw += w;
+                    swv += w * value[bestId[j][c]];
+                }
+                row[c] = sw > 0.0 ? (float)(swv / sw) : std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+    }
+    return raster;
+}
+
+std::vector<Raster> IdwInterpolator::interpolateSeries(uint16_t parameterId, int32_t utcFrom, int32_t utcTo, int32_t bucketMinutes,
+                                                       const GridSpec& grid, const IdwOptions& options) const {
+    std::vector<Raster> out;
+    if (bucketMinutes <= 0 || utcTo <= utcFrom) return out;
+    const long long buckets = ((long long)utcTo - utcFrom + bucketMinutes - 1) / bucketMinutes;
+    out.resize((size_t)buckets);
+    // Buckets are independent; the per-bucket tile loop runs serially inside
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long b = 0; b < buckets; ++b) {
+        const int32_t t0 = (int32_t)(utcFrom + b * bucketMinutes);
+        const int32_t t1 = (int32_t)std::min<long long>(utcTo, (long long)t0 + bucketMinutes);
+        out[b] = interpolate(parameterId, t0, t1, grid, options);
+    }
+    return out;
+}
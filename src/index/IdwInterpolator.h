@@ -0,0 +1,69 @@
+#pragma once
+#include "../utility/Records.h"
+#include "SiteIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Regular lat/lon grid of cell centres; row 0 is the northern edge.
+struct GridSpec {
+    double lat_min = 0.0, lat_max = 0.0, lon_min = 0.0, lon_max = 0.0;
+    uint32_t rows = 0, cols = 0;
+
+    double cellLat(uint32_t r) const { return lat_max - (r + 0.5) * (lat_max - lat_min) / rows; }
+    double cellLon(uint32_t c) const { return lon_min + (c + 0.5) * (lon_max - lon_min) / cols; }
+    size_t cells() const { return (size_t)rows * cols; }
+};
+
+// Dense interpolated surface for one time bucket.
+struct Raster {
+    GridSpec grid;
+    int32_t utc_from = 0, utc_to = 0;   // bucket [utc_from, utc_to)
+    size_t sites = 0;                   // sites that reported in the bucket
+    std::vector<float> values;          // row-major; NaN where no site is in range
+
+    float at(uint32_t r, uint32_t c) const { return values[(size_t)r * grid.cols + c]; }
+};
+
+struct IdwOptions {
+    size_t neighbors = 8;       // k, clamped to [1, IdwInterpolator::kMaxNeighbors]
+    double power = 2.0;
+    double max_km = 0.0;        // ignore sites farther than this; 0 = no limit
+};
+
+// Inverse-distance-weighted surface from per-site readings. Each site's
+// readings of the parameter in the bucket are averaged; each cell then
+// weights its k nearest reporting sites by 1 / d^power.
+//
+// Cells are processed in tiles. A k-d tree over the reporting sites gives
+// each tile a candidate list that provably holds every cell's k nearest
+// sites (triangle inequality around the tile centre); the per-cell top-k and
+// the weighting run with omp simd across the tile's cells. Ranking and
+// weights use chord distance on the unit sphere, within 0.03% of the
+// great-circle distance below 500 km.
+class IdwInterpolator {
+public:
+    static constexpr size_t kMaxNeighbors = 32;
+
+    // `sites` must be built over `records`; both must outlive the interpolator.
+    IdwInterpolator(const FireRecords& records, const SiteIndex& sites) : records_(records), sites_(sites) {}
+
+    // One bucket; parallel across tiles of cells.
+    Raster interpolate(uint16_t parameterId, int32_t utcFrom, int32_t utcTo,
+                       const GridSpec& grid, const IdwOptions& options = {}) const;
+
+    // Consecutive buckets of bucketMinutes covering [utcFrom, utcTo);
+    // parallel across buckets.
+    std::vector<Raster> interpolateSeries(uint16_t parameterId, int32_t utcFrom, int32_t utcTo, int32_t bucketMinutes,
+                                          const GridSpec& grid, const IdwOptions& options = {}) const;
+
+private:
+    struct Reporting {
+        std::vector<float> latitude, longitude, value;   // one entry per reporting site
+    };
+
+    Reporting site_means(uint16_t parameterId, int32_t utcFrom, int32_t utcTo) const;
+
+    const FireRecords& records_;
+    const SiteIndex& sites_;
+};
@@ -0,0 +1,106 @@
+#include "index/PointIndex.h"
+#include "utility/Interleave.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+
+void PointIndex::build(const FireRecords& records) {
+    records_ = &records;
+    rows_ = records.size();
+
+    // (region, row) pairs; the radix sort groups them by region, rows ascending
+    std::vector<uint64_t> hashes(rows_);
+    std::vector<std::pair<uint32_t, uint32_t>> byRegion(rows_);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)rows_; ++i) {
+        const FireRecord& r = records[i];
+        hashes[i] = hash(r.site_id, r.parameter_id, hour_of(r.utc_minutes));
+        byRegion[i] = {(uint32_t)(hashes[i] >> 58), (uint32_t)i};
+    }
+    parallel_radix_sort(byRegion);
+
+    // Each region gets a power of two at most 3/4 full
+    size_t counts[kRegions] = {}, begin[kRegions] = {};
+    for (const auto& e : byRegion) ++counts[e.first];
+    size_t total = 0;
+    for (size_t g = 0; g < kRegions; ++g) {
+        size_t cap = 1;
+        while (cap * 3 < counts[g] * 4 + 1) cap <<= 1;
+        regions_[g] = {total, cap - 1};
+        begin[g] = g ? begin[g - 1] + counts[g - 1] : 0;
+        total += cap;
+    }
+    slots_.assign(total, kEmpty);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long g = 0; g < (long long)kRegions; ++g) {
+        const Region& region = regions_[g];
+        for (size_t k = begin[g]; k < begin[g] + counts[g]; ++k) {
+            const uint32_t row = byRegion[k].second;
+            const uint64_t h = hashes[row];
+            size_t pos = (size_t)(h >> 32) & region.mask;
+            while (slots_[region.base + pos] != kEmpty) pos = (pos + 1) & region.mask;
+            slots_[region.base + pos] = (h << 32) | row;
+        }
+    }
+}
+
+uint32_t PointIndex::lookup(uint32_t site, uint16_t parameter, int32_t utcMinutes) const {
+    if (slots_.empty()) return kNotFound;
+    const int32_t hour = hour_of(utcMinutes);
+    const uint64_t h = hash(site, parameter, hour);
+    const Region& region = regions_[h >> 58];
+    for (size_t pos = (size_t)(h >> 32) & region.mask;; pos = (pos + 1) & region.mask) {
+        const uint64_t slot = slots_[region.base + pos];
+        if (slot == kEmpty) return kNotFound;
+        // Probe order within a region is insertion (row) order
+        if ((uint32_t)(slot >> 32) == (uint32_t)h && matches((uint32_t)slot, site, parameter, hour)) return (uint32_t)slot;
+    }
+}
+
+void PointIndex::lookupBatch(const Key* keys, size_t n, uint32_t* rows, size_t group) const {
+    if (slots_.empty()) {
+        std::fill(rows, rows + n, kNotFound);
+        return;
+    }
+    // One in-flight lookup: probing a slot, or checking the record of a tag match
+    struct State {
+        size_t i;
+        uint64_t h;
+        int32_t hour;
+        const Region* region;
+        size_t pos;
+        bool verify;
+    };
+    interleave_lookups<State>(n, group,
+        [&](size_t i, State& st) {
+            st.i = i;
+            st.hour = hour_of(keys[i].utcMinutes);
+            st.h = hash(keys[i].site, keys[i].parameter, st.hour);
+            st.region = &regions_[st.h >> 58];
+            st.pos = (size_t)(st.h >> 32) & st.region->mask;
+            st.verify = false;
+            __builtin_prefetch(&slots_[st.region->base + st.pos]);
+        },
+        [&](State& st) {
+            const uint64_t slot = slots_[st.region->base + st.pos];
+            if (st.verify) {
+                const Key& k = keys[st.i];
+                if (matches((uint32_t)slot, k.site, k.parameter, st.hour)) {
+                    rows[st.i] = (uint32_t)slot;
+                    return true;
+                }
+                st.verify = false;
+            } else if (slot == kEmpty) {
+                rows[st.i] = kNotFound;
+                return true;
+            } else if ((uint32_t)(slot >> 32) == (uint32_t)st.h) {
+                st.verify = true;
+                __builtin_prefetch(&(*records_)[(uint32_t)slot]);
+                return false;
+            }
+            st.pos = (st.pos + 1) & st.region->mask;
+            __builtin_prefetch(&slots_[st.region->base + st.pos]);
+            return false;
+        });
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "../utility/Records.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash index from (site_id, parameter_id, UTC hour) to rows
+// of fire_records_. A slot is 8 bytes: the row and 32 hash bits as a tag;
+// keys are not stored but checked against the record on a tag match, so
+// the records must not move once built.
+//
+// The table is split into 64 regions by the top hash bits, each a power of
+// two probed linearly within itself. The build groups rows by region with
+// a radix pass and fills the regions in parallel, in row order, so the
+// first match of a key is its first row.
+class PointIndex {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    struct Key {
+        uint32_t site = 0;          // FireRecord::site_id (site dimension row)
+        uint16_t parameter = 0;
+        int32_t utcMinutes = 0;     // any minute of the hour
+    };
+
+    void build(const FireRecords& records);
+
+    // First row with the key, or kNotFound
+    uint32_t lookup(uint32_t site, uint16_t parameter, int32_t utcMinutes) const;
+
+    // Every row with the key, in row order
+    template <typename Fn>
+    void forEach(uint32_t site, uint16_t parameter, int32_t utcMinutes, Fn fn) const {
+        if (slots_.empty()) return;
+        const int32_t hour = hour_of(utcMinutes);
+        const uint64_t h = hash(site, parameter, hour);
+        const Region& region = regions_[h >> 58];
+        for (size_t pos = (size_t)(h >> 32) & region.mask;; pos = (pos + 1) & region.mask) {
+            const uint64_t slot = slots_[region.base + pos];
+            if (slot == kEmpty) return;
+            if ((uint32_t)(slot >> 32) == (uint32_t)h && matches((uint32_t)slot, site, parameter, hour)) fn((uint32_t)slot);
+        }
+    }
+
+    // rows[i] = lookup(keys[i]), with `group` lookups (1..kMaxInterleave)
+    // interleaved: each one prefetches its next slot or candidate record and
+    // yields to the others before touching it, so their misses overlap.
+    static constexpr size_t kBatch = 16;
+    void lookupBatch(const Key* keys, size_t n, uint32_t* rows, size_t group = kBatch) const;
+
+    size_t size() const { return rows_; }
+    size_t capacity() const { return slots_.size(); }
+    size_t memoryBytes() const { return slots_.capacity() * sizeof(uint64_t) + sizeof(regions_); }
+
+    static int32_t hour_of(int32_t utcMinutes) {
+        return utcMinutes >= 0 ? utcMinutes / 60 : -((-utcMinutes + 59) / 60);
+    }
+
+private:
+    static constexpr uint64_t kEmpty = ~uint64_t(0);
+    static constexpr size_t kRegions = 64;
+
+    struct Region { size_t base = 0, mask = 0; };
+
+    static uint64_t hash(uint32_t site, uint16_t parameter, int32_t hour) {
+        uint64_t x = ((uint64_t)site << 32 | (uint32_t)hour) ^ ((uint64_t)parameter * 0x9e3779b97f4a7c15ULL);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    bool matches(uint32_t row, uint32_t site, uint16_t parameter, int32_t hour) const {
+        const FireRecord& r = (*records_)[row];
+        return r.site_id == site && r.parameter_id == parameter && hour_of(r.utc_minutes) == hour;
+    }
+
+    const FireRecords* records_ = nullptr;
+    size_t rows_ = 0;
+    Region regions_[kRegions];
+    std::vector<uint64_t> slots_;
+};
@@ -0,0 +1,151 @@
+#include "index/PolygonFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+PolygonFilter::PolygonFilter(const GeoShape& shape, int gridSize) {
+    for (const auto& ring : shape.rings) {
+        for (size_t i = 0; i < ring.size(); ++i) {
+            const GeoShape::Point& a = ring[i];
+            const GeoShape::Point& b = ring[(i + 1) % ring.size()];
+            if (a.lon == b.lon && a.lat == b.lat) continue;
+            ax_.push_back(a.lon); ay_.push_back(a.lat);
+            bx_.push_back(b.lon); by_.push_back(b.lat);
+        }
+    }
+    if (ax_.empty()) return;
+
+    min_x_ = max_x_ = ax_[0];
+    min_y_ = max_y_ = ay_[0];
+    for (size_t e = 0; e < ax_.size(); ++e) {
+        min_x_ = std::min({min_x_, ax_[e], bx_[e]}); max_x_ = std::max({max_x_, ax_[e], bx_[e]});
+        min_y_ = std::min({min_y_, ay_[e], by_[e]}); max_y_ = std::max({max_y_, ay_[e], by_[e]});
+    }
+    nx_ = ny_ = std::max(1, gridSize);
+    cell_w_ = std::max((max_x_ - min_x_) / nx_, 1e-12);
+    cell_h_ = std::max((max_y_ - min_y_) / ny_, 1e-12);
+
+    // Edges -> cells they pass through (supercover, column by column)
+    std::vector<std::vector<uint32_t>> cellEdges((size_t)nx_ * ny_);
+    for (size_t e = 0; e < ax_.size(); ++e) mark_edge(ax_[e], ay_[e], bx_[e], by_[e], cellEdges, (uint32_t)e);
+
+    state_.assign((size_t)nx_ * ny_, kOutside);
+    center_inside_.assign((size_t)nx_ * ny_, 0);
+    cell_begin_.assign((size_t)nx_ * ny_ + 1, 0);
+    const long long cells = (long long)nx_ * ny_;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long c = 0; c < cells; ++c) {
+        const double cx = min_x_ + ((double)(c % nx_) + 0.5) * cell_w_;
+        const double cy = min_y_ + ((double)(c / nx_) + 0.5) * cell_h_;
+        const bool in = containsExact(cy, cx);
+        center_inside_[c] = in;
+        state_[c] = !cellEdges[c].empty() ? kBoundary : in ? kInside : kOutside;
+    }
+    for (long long c = 0; c < cells; ++c) {
+        cell_begin_[c + 1] = cell_begin_[c] + (uint32_t)cellEdges[c].size();
+        for (uint32_t e : cellEdges[c]) {
+            cax_.push_back(ax_[e]); cay_.push_back(ay_[e]);
+            cbx_.push_back(bx_[e]); cby_.push_back(by_[e]);
+        }
+    }
+}
+
+void PolygonFilter::mark_edge(double x0, double y0, double x1, double y1,
+                              std::vector<std::vector<uint32_t>>& cellEdges, uint32_t edge) {
+    if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+    // Slightly widened so rounding at cell borders never drops a cell
+    const double epsX = cell_w_ * 1e-9, epsY = cell_h_ * 1e-9;
+    auto col = [&](double x) { return std::min(nx_ - 1, std::max(0, (int)std::floor((x - min_x_) / cell_w_))); };
+    auto row = [&](double y) { return std::min(ny_ - 1, std::max(0, (int)std::floor((y - min_y_) / cell_h_))); };
+    const int c0 = col(x0 - epsX), c1 = col(x1 + epsX);
+    for (int c = c0; c <= c1; ++c) {
+        // Segment's y extent within this column
+        double xa = std::max(x0, min_x_ + c * cell_w_), xb = std::min(x1, min_x_ + (c + 1) * cell_w_);
+        double ya = y0, yb = y1;
+        if (x1 > x0) {
+            ya = y0 + (y1 - y0) * (xa - x0) / (x1 - x0);
+            yb = y0 + (y1 - y0) * (xb - x0) / (x1 - x0);
+        }
+        const int r0 = row(std::min(ya, yb) - epsY), r1 = row(std::max(ya, yb) + epsY);
+        for (int r = r0; r <= r1; ++r) {
+            auto& list = cellEdges[(size_t)r * nx_ + c];
+            if (list.empty() || list.back() != edge) list.push_back(edge);
+        }
+    }
+}
+
+bool PolygonFilter::containsExact(double lat, double lon) const {
+    // Even-odd rule: horizontal ray towards +x
+    bool in = false;
+    for (size_t e = 0; e < ax_.size(); ++e) {
+        const bool straddles = (ay_[e] > lat) != (by_[e] > lat);
+        if (straddles) {
+            const double xCross = ax_[e] + (lat - ay_[e]) * (bx_[e] - ax_[e]) / (by_[e] - ay_[e]);
+            if (lon < xCross) in = !in;
+        }
+    }
+    return in;
+}
+
+bool PolygonFilter::boundary_contains(size_t cell, double x, double y) const {
+    const double cx = min_x_ + ((double)(cell % nx_) + 0.5) * cell_w_;
+    const double cy = min_y_ + ((double)(cell / nx_) + 0.5) * cell_h_;
+    const uint32_t b = cell_begin_[cell], end = cell_begin_[cell + 1];
+    const double* ax = cax_.data();
+    const double* ay = cay_.data();
+    const double* bx = cbx_.data();
+    const double* by = cby_.data();
+
+    // Proper crossings of segment (c -> p) with each cell edge (a -> b)
+    int crossings = 0;
+    #pragma omp simd reduction(+:crossings)
+    for (uint32_t i = b; i < end; ++i) {
+        const double d1 = (bx[i] - ax[i]) * (cy - ay[i]) - (by[i] - ay[i]) * (cx - ax[i]);
+        const double d2 = (bx[i] - ax[i]) * (y - ay[i]) - (by[i] - ay[i]) * (x - ax[i]);
+        const double d3 = (x - cx) * (ay[i] - cy) - (y - cy) * (ax[i] - cx);
+        const double d4 = (x - cx) * (by[i] - cy) - (y - cy) * (bx[i] - cx);
+        crossings += ((d1 > 0) != (d2 > 0)) & ((d3 > 0) != (d4 > 0));
+    }
+    return center_inside_[cell] ^ (crossings & 1);
+}
+
+bool PolygonFilter::contains(double lat, double lon) const {
+    if (ax_.empty() || !(lon >= min_x_ && lon <= max_x_ && lat >= min_y_ && lat <= max_y_)) return false;
+    const int c = std::min(nx_ - 1, (int)((lon - min_x_) / cell_w_));
+    const int r = std::min(ny_ - 1, (int)((lat - min_y_) / cell_h_));
+    const size_t cell = (size_t)r * nx_ + c;
+    switch (state_[cell]) {
+        case kInside:  return true;
+        case kOutside: return false;
+        default:       return boundary_contains(cell, lon, lat);
+    }
+}
+
+std::vector<uint32_t> PolygonFilter::filter(const FireRecords& records, const SiteTable& sites) const {
+    std::vector<uint8_t> inside(sites.size());
+    const long long nSites = (long long)sites.size();
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long s = 0; s < nSites; ++s) inside[s] = contains(sites[s].latitude, sites[s].longitude);
+
+    // Fixed chunks keep the output in row order regardless of scheduling
+    const size_t chunk = 1 << 16;
+    const long long chunks = (long long)((records.size() + chunk - 1) / chunk);
+    std::vector<std::vector<uint32_t>> parts((size_t)chunks);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long k = 0; k < chunks; ++k) {
+        const size_t begin = (size_t)k * chunk, end = std::min(records.size(), begin + chunk);
+        for (size_t i = begin; i < end; ++i) {
+            if (inside[records[i].site_id]) parts[k].push_back((uint32_t)i);
+        }
+    }
+    std::vector<uint32_t> out;
+    size_t total = 0;
+    for (const auto& p : parts) total += p.size();
+    out.reserve(total);
+    for (const auto& p : parts) out.insert(out.end(), p.begin(), p.end());
+    return out;
+}
+
+size_t PolygonFilter::boundaryCells() const {
+    return (size_t)std::count(state_.begin(), state_.end(), (uint8_t)kBoundary);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "../utility/GeoShapes.h"
+#include "../utility/Records.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Point-in-polygon operator for one GeoShape. The shape's bounding box is
+// rasterized into a grid; cells no edge touches are wholly inside or
+// outside and answer immediately. For boundary cells the cell centre's
+// state is precomputed, and a point flips it once per cell edge crossed by
+// the segment centre -> point, tested over the cell's edges with omp simd.
+class PolygonFilter {
+public:
+    explicit PolygonFilter(const GeoShape& shape, int gridSize = 64);
+
+    bool contains(double lat, double lon) const;
+
+    // Row ids inside the shape, in row order. Each site is tested once; rows
+    // then pass by site_id. Both passes are parallel.
+    std::vector<uint32_t> filter(const FireRecords& records, const SiteTable& sites) const;
+
+    // Plain even-odd ray casting against every edge (reference path).
+    bool containsExact(double lat, double lon) const;
+
+    size_t edgeCount() const { return ax_.size(); }
+    size_t boundaryCells() const;
+
+private:
+    enum CellState : uint8_t { kOutside, kInside, kBoundary };
+
+    void mark_edge(double x0, double y0, double x1, double y1, std::vector<std::vector<uint32_t>>& cellEdges, uint32_t edge);
+    bool boundary_contains(size_t cell, double x, double y) const;
+
+    // Edges (all rings), structure-of-arrays: (ax, ay) -> (bx, by) in lon/lat
+    std::vector<double> ax_, ay_, bx_, by_;
+
+    double min_x_ = 0, min_y_ = 0, max_x_ = 0, max_y_ = 0;
+    double cell_w_ = 1, cell_h_ = 1;
+    int nx_ = 0, ny_ = 0;
+    std::vector<uint8_t> state_;          // per cell
+    std::vector<uint8_t> center_inside_;  // per cell, boundary cells only meaningful
+
+    // Per boundary cell, its edges copied contiguously (CSR) for the simd loop
+    std::vector<uint32_t> cell_begin_;
+    std::vector<double> cax_, cay_, cbx_, cby_;
+};
@@ -0,0 +1,129 @@
+#include "index/SegmentBloom.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// splitmix64 finalizer: the high half picks the block, the low half the bits
+uint64_t mix(uint32_t key) {
+    uint64_t x = key + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Odd multipliers, one per word (as in Parquet's split-block filter)
+constexpr uint32_t kSalt[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                               0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+int32_t hour_of(int32_t utcMinutes) {
+    return utcMinutes >= 0 ? utcMinutes / 60 : -((-utcMinutes + 59) / 60);
+}
+
+} // namespace
+
+void BlockedBloom::build(const std::vector<uint32_t>& keys, double bitsPerKey) {
+    const size_t bits = (size_t)std::ceil((double)keys.size() * bitsPerKey);
+    blocks_.assign(std::max<size_t>(1, (bits + 255) / 256), Block{});
+    for (uint32_t key : keys) {
+        const uint64_t h = mix(key);
+        Block& b = blocks_[(size_t)(((h >> 32) * blocks_.size()) >> 32)];
+        for (int i = 0; i < 8; ++i) b.word[i] |= 1U << (((uint32_t)h * kSalt[i]) >> 27);
+    }
+}
+
+bool BlockedBloom::mayContain(uint32_t key) const {
+    if (blocks_.empty()) return false;
+    const uint64_t h = mix(key);
+    const Block& b = blocks_[(size_t)(((h >> 32) * blocks_.size()) >> 32)];
+    uint32_t missing = 0;
+    for (int i = 0; i < 8; ++i) missing |= ~b.word[i] & (1U << (((uint32_t)h * kSalt[i]) >> 27));
+    return missing == 0;
+}
+
+void SegmentBloom::build(const FireRecords& records, const SiteTable& sites) {
+    segments_.clear();
+    runs_.clear();
+
+    // Maximal same-hour runs in row order, then one segment per distinct hour
+    std::vector<int32_t> runHours;
+    for (size_t i = 0; i < records.size(); ++i) {
+        const int32_t hour = hour_of(records[i].utc_minutes);
+        if (runs_.empty() || runHours.back() != hour) {
+            runs_.push_back({(uint32_t)i, (uint32_t)i, 0});
+            runHours.push_back(hour);
+        }
+        runs_.back().end = (uint32_t)i + 1;
+    }
+    std::vector<int32_t> hours = runHours;
+    std::sort(hours.begin(), hours.end());
+    hours.erase(std::unique(hours.begin(), hours.end()), hours.end());
+    segments_.resize(hours.size());
+    std::vector<std::vector<uint32_t>> segmentRuns(hours.size());
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        const size_t s = (size_t)(std::lower_bound(hours.begin(), hours.end(), runHours[r]) - hours.begin());
+        runs_[r].segment = (uint32_t)s;
+        segmentRuns[s].push_back((uint32_t)r);
+    }
+
+    // Id space of each key, for the per-thread "seen in segment" stamps
+    size_t idCount[(size_t)Key::Count] = {0, 0, 0};
+    for (const SiteRecord& site : sites) {
+        idCount[(size_t)Key::Site] = std::max<size_t>(idCount[(size_t)Key::Site], (size_t)site.name_id + 1);
+        idCount[(size_t)Key::Aqs] = std::max<size_t>(idCount[(size_t)Key::Aqs], (size_t)site.aqs_id + 1);
+        idCount[(size_t)Key::Agency] = std::max<size_t>(idCount[(size_t)Key::Agency], (size_t)site.agency_id + 1);
+    }
+
+    #pragma omp parallel
+    {
+        // Segment + 1 that last saw each site row / id, so ids come out distinct
+        std::vector<uint32_t> seenSite(sites.size(), 0);
+        std::vector<uint32_t> seen[(size_t)Key::Count];
+        for (size_t k = 0; k < (size_t)Key::Count; ++k) seen[k].assign(idCount[k], 0);
+        #pragma omp for schedule(dynamic, 4)
+        for (long long s = 0; s < (long long)segments_.size(); ++s) {
+            Segment& segment = segments_[s];
+            segment.hour = hours[s];
+            const uint32_t stamp = (uint32_t)s + 1;
+            std::vector<uint32_t> ids[(size_t)Key::Count];
+            auto add = [&](Key key, uint32_t id) {
+                if (seen[(size_t)key][id] == stamp) return;
+                seen[(size_t)key][id] = stamp;
+                ids[(size_t)key].push_back(id);
+            };
+            for (uint32_t r : segmentRuns[s]) {
+                for (uint32_t i = runs_[r].begin; i < runs_[r].end; ++i) {
+                    const uint32_t row = records[i].site_id;
+                    if (seenSite[row] == stamp) continue;
+                    seenSite[row] = stamp;
+                    const SiteRecord& site = sites[row];
+                    add(Key::Site, site.name_id);
+                    add(Key::Aqs, site.aqs_id);
+                    add(Key::Agency, site.agency_id);
+                }
+            }
+            for (size_t k = 0; k < (size_t)Key::Count; ++k) segment.filter[k].build(ids[k]);
+        }
+    }
+}
+
+bool SegmentBloom::mayContain(Key key, size_t s, long long lo, long long hi) const {
+    lo = std::max(lo, 0LL);
+    hi = std::min(hi, (long long)UINT32_MAX);
+    if (hi < lo) return false;
+    if (hi - lo >= kMaxProbeIds) return true;
+    const BlockedBloom& filter = segments_[s].filter[(size_t)key];
+    for (long long id = lo; id <= hi; ++id) {
+        if (filter.mayContain((uint32_t)id)) return true;
+    }
+    return false;
+}
+
+size_t SegmentBloom::memoryBytes() const {
+    size_t bytes = segments_.capacity() * sizeof(Segment) + runs_.capacity() * sizeof(Run);
+    for (const Segment& s : segments_) {
+        for (const BlockedBloom& f : s.filter) bytes += f.memoryBytes();
+    }
+    return bytes;
+}
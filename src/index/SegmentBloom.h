@@ -0,0 +1,69 @@
+#pragma once
+#include "../utility/Records.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Split-block Bloom filter over 32-bit ids. A key picks one 32-byte block
+// and sets one bit in each of its eight words, so a probe reads a single
+// cache line. About 10 bits per key gives roughly 1% false positives.
+class BlockedBloom {
+public:
+    void build(const std::vector<uint32_t>& keys, double bitsPerKey = 10.0);
+    bool mayContain(uint32_t key) const;
+    size_t memoryBytes() const { return blocks_.capacity() * sizeof(Block); }
+
+private:
+    struct Block { uint32_t word[8]; };
+    std::vector<Block> blocks_;
+};
+
+// Bloom filters on the site columns of each UTC hour ("segment"). Rows of
+// one hour may sit in several runs (clustered orders); a point or short
+// id range skips every run whose hour cannot hold any of the ids. Runs are
+// visited in row order, so results match a full scan.
+class SegmentBloom {
+public:
+    enum class Key { Site, Aqs, Agency, Count };   // SiteRecord name_id, aqs_id, agency_id
+
+    // Id ranges wider than this are not probed (every segment is scanned)
+    static constexpr long long kMaxProbeIds = 16;
+
+    // Replaces the contents; segments build in parallel.
+    void build(const FireRecords& records, const SiteTable& sites);
+
+    size_t segments() const { return segments_.size(); }
+    size_t runs() const { return runs_.size(); }
+
+    // Whether segment s may hold a row whose key is in [lo, hi]
+    bool mayContain(Key key, size_t s, long long lo, long long hi) const;
+
+    // Rows [begin, end) of each run whose segment may hold a key in [lo, hi],
+    // in row order; returns the number of segments skipped.
+    template <typename Fn>
+    size_t forEachRun(Key key, long long lo, long long hi, Fn fn) const {
+        std::vector<char> keep(segments_.size());
+        size_t skipped = 0;
+        for (size_t s = 0; s < segments_.size(); ++s) {
+            keep[s] = mayContain(key, s, lo, hi);
+            skipped += keep[s] ? 0 : 1;
+        }
+        for (const Run& run : runs_) {
+            if (keep[run.segment]) fn(run.begin, run.end);
+        }
+        return skipped;
+    }
+
+    int32_t segmentHour(size_t s) const { return segments_[s].hour; }
+    size_t memoryBytes() const;
+
+private:
+    struct Segment {
+        int32_t hour = 0;   // utc_minutes / 60
+        BlockedBloom filter[(size_t)Key::Count];
+    };
+    struct Run { uint32_t begin, end, segment; };
+
+    std::vector<Segment> segments_;   // ascending hour
+    std::vector<Run> runs_;           // row order
+};
@@ -0,0 +1,179 @@
+#include "index/SiteIndex.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+static void to_unit(double lat, double lon, double out[3]) {
+    const double la = lat * kDegToRad, lo = lon * kDegToRad;
+    out[0] = std::cos(la) * std::cos(lo);
+    out[1] = std::cos(la) * std::sin(lo);
+    out[2] = std::sin(la);
+}
+
+double SiteIndex::haversineKm(double lat1, double lon1, double lat2, double lon2) {
+    const double dLat = (lat2 - lat1) * kDegToRad, dLon = (lon2 - lon1) * kDegToRad;
+    const double a = std::sin(dLat / 2) * std::sin(dLat / 2)
+                   + std::cos(lat1 * kDegToRad) * std::cos(lat2 * kDegToRad) * std::sin(dLon / 2) * std::sin(dLon / 2);
+    return 2.0 * kEarthRadiusKm * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+// -------- build --------
+void SiteIndex::clear() {
+    sites_.clear();
+    slot_of_.clear();
+    rows_.clear();
+    tree_.clear();
+    axis_.clear();
+}
+
+void SiteIndex::build(const FireRecords& records, const SiteTable& sites) {
+    clear();
+    if (records.empty()) return;
+
+    // Sites with rows, in site_id order; coordinates from the site dimension
+    slot_of_.assign(sites.size(), UINT32_MAX);
+    std::vector<uint32_t> counts(sites.size(), 0);
+    for (const auto& r : records) ++counts[r.site_id];
+    uint32_t offset = 0;
+    for (uint32_t id = 0; id < (uint32_t)sites.size(); ++id) {
+        if (!counts[id]) continue;
+        slot_of_[id] = (uint32_t)sites_.size();
+        sites_.push_back(Site{id, sites[id].latitude, sites[id].longitude, offset, offset});
+        offset += counts[id];
+    }
+
+    // Rows in time order (parallel radix sort, ties by row), then a stable
+    // counting-sort scatter into per-site buckets keeps that order per site
+    std::vector<std::pair<int32_t, uint32_t>> byTime(records.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)records.size(); ++i) byTime[i] = {records[i].utc_minutes, (uint32_t)i};
+    parallel_radix_sort(byTime);
+    rows_.resize(records.size());
+    for (const auto& entry : byTime) {
+        Site& s = sites_[slot_of_[records[entry.second].site_id]];
+        rows_[s.rows_end++] = entry.second;
+    }
+    build_points();
+}
+
+void SiteIndex::buildSites(const SiteTable& sites) {
+    clear();
+    slot_of_.resize(sites.size());
+    sites_.resize(sites.size());
+    for (uint32_t id = 0; id < (uint32_t)sites.size(); ++id) {
+        slot_of_[id] = id;
+        sites_[id] = Site{id, sites[id].latitude, sites[id].longitude, 0, 0};
+    }
+    build_points();
+}
+
+// k-d tree over the unit vectors of sites_
+void SiteIndex::build_points() {
+    tree_.resize(sites_.size());
+    axis_.assign(sites_.size(), 0);
+    for (size_t s = 0; s < sites_.size(); ++s) {
+        double p[3];
+        to_unit(sites_[s].latitude, sites_[s].longitude, p);
+        tree_[s] = Point{p[0], p[1], p[2], (uint32_t)s};
+    }
+    #pragma omp parallel
+    #pragma omp single
+    build_tree(0, tree_.size());
+}
+
+void SiteIndex::build_tree(size_t lo, size_t hi) {
+    if (hi - lo <= 1) return;
+    // Split on the axis with the largest spread
+    double mn[3] = {2, 2, 2}, mx[3] = {-2, -2, -2};
+    for (size_t i = lo; i < hi; ++i) {
+        const double c[3] = {tree_[i].x, tree_[i].y, tree_[i].z};
+        for (int a = 0; a < 3; ++a) { mn[a] = std::min(mn[a], c[a]); mx[a] = std::max(mx[a], c[a]); }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; ++a) if (mx[a] - mn[a] > mx[axis] - mn[axis]) axis = a;
+
+    const size_t mid = lo + (hi - lo) / 2;
+    auto coord = [axis](const Point& p) { return axis == 0 ? p.x : axis == 1 ? p.y : p.z; };
+    std::nth_element(tree_.begin() + lo, tree_.begin() + mid, tree_.begin() + hi,
+        [&](const Point& a, const Point& b) { return coord(a) < coord(b); });
+    axis_[mid] = (uint8_t)axis;
+
+    if (hi - lo > 2048) {
+        #pragma omp task
+        build_tree(lo, mid);
+        #pragma omp task
+        build_tree(mid + 1, hi);
+        #pragma omp taskwait
+    } else {
+        build_tree(lo, mid);
+        build_tree(mid + 1, hi);
+    }
+}
+
+// -------- queries --------
+const SiteIndex::Site* SiteIndex::findSite(uint32_t siteId) const {
+    if (siteId >= slot_of_.size() || slot_of_[siteId] == UINT32_MAX) return nullptr;
+    return &sites_[slot_of_[siteId]];
+}
+
+std::vector<uint32_t> SiteIndex::latestRows(const Site& s, const FireRecords& records) const {
+    std::vector<uint32_t> out;
+    if (s.rows_begin == s.rows_end) return out;
+    const int32_t newest = records[rows_[s.rows_end - 1]].utc_minutes;
+    for (uint32_t i = s.rows_end; i > s.rows_begin && records[rows_[i - 1]].utc_minutes == newest; --i) {
+        out.push_back(rows_[i - 1]);
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+void SiteIndex::search(size_t lo, size_t hi, const double q[3], size_t k,
+                       std::vector<std::pair<double, uint32_t>>& heap) const {
+    if (lo >= hi) return;
+    const size_t mid = lo + (hi - lo) / 2;
+    const Point& p = tree_[mid];
+    const double dx = p.x - q[0], dy = p.y - q[1], dz = p.z - q[2];
+    const double d2 = dx * dx + dy * dy + dz * dz;
+    if (heap.size() < k) {
+        heap.emplace_back(d2, p.site);
+        std::push_heap(heap.begin(), heap.end());
+    } else if (d2 < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {d2, p.site};
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    const int axis = axis_[mid];
+    const double diff = q[axis] - (axis == 0 ? p.x : axis == 1 ? p.y : p.z);
+    const bool leftFirst = diff < 0;
+    search(leftFirst ? lo : mid + 1, leftFirst ? mid : hi, q, k, heap);
+    if (heap.size() < k || diff * diff < heap.front().first) {
+        search(leftFirst ? mid + 1 : lo, leftFirst ? hi : mid, q, k, heap);
+    }
+}
+
+std::vector<SiteIndex::Neighbor> SiteIndex::nearest(double lat, double lon, size_t k) const {
+    std::vector<Neighbor> out;
+    if (k == 0 || tree_.empty()) return out;
+    double q[3];
+    to_unit(lat, lon, q);
+    std::vector<std::pair<double, uint32_t>> heap;   // max-heap on chord^2
+    heap.reserve(k + 1);
+    search(0, tree_.size(), q, k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    out.reserve(heap.size());
+    for (const auto& entry : heap) {
+        // Report the haversine distance from the stored coordinates
+        const Site& s = sites_[entry.second];
+        out.push_back(Neighbor{entry.second, haversineKm(lat, lon, s.latitude, s.longitude)});
+    }
+    return out;
+}
+
+size_t SiteIndex::memoryBytes() const {
+    return sites_.capacity() * sizeof(Site) + slot_of_.capacity() * sizeof(uint32_t)
+         + rows_.capacity() * sizeof(uint32_t) + tree_.capacity() * sizeof(Point) + axis_.capacity();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "../utility/Records.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Distinct monitoring sites with a per-site row index and a k-d tree over
+// their coordinates. Points are unit vectors on the sphere, so Euclidean
+// (chord) distance orders exactly like great-circle distance and the tree
+// answers haversine k-nearest queries without approximation.
+class SiteIndex {
+public:
+    struct Site {
+        uint32_t site_id = 0;       // site dimension row, as in FireRecord
+        float latitude = 0.0f;
+        float longitude = 0.0f;
+        uint32_t rows_begin = 0;    // [rows_begin, rows_end) in rows(), oldest first
+        uint32_t rows_end = 0;
+    };
+
+    struct Neighbor {
+        uint32_t site = 0;          // index into sites()
+        double distance_km = 0.0;
+    };
+
+    static constexpr double kEarthRadiusKm = 6371.0088;
+
+    // Parallel: one radix sort of all rows by time, then a stable
+    // counting-sort scatter into per-site buckets, which keeps each bucket
+    // in time order; the tree's subtrees build as OpenMP tasks.
+    void build(const FireRecords& records, const SiteTable& sites);
+
+    // Only the k-d tree, over every row of sites (sites()[i] is row i, with
+    // no rows of its own), for callers that need nearest() alone.
+    void buildSites(const SiteTable& sites);
+
+    const std::vector<Site>& sites() const { return sites_; }
+    const Site* findSite(uint32_t siteId) const;
+
+    // Row ids of a site in utc order.
+    const uint32_t* rowsBegin(const Site& s) const { return rows_.data() + s.rows_begin; }
+    const uint32_t* rowsEnd(const Site& s) const { return rows_.data() + s.rows_end; }
+
+    // Rows at the site's newest timestamp (one per parameter reported then).
+    std::vector<uint32_t> latestRows(const Site& s, const FireRecords& records) const;
+
+    // k closest sites, nearest first.
+    std::vector<Neighbor> nearest(double lat, double lon, size_t k) const;
+
+    static double haversineKm(double lat1, double lon1, double lat2, double lon2);
+
+    size_t memoryBytes() const;
+
+private:
+    struct Point { double x, y, z; uint32_t site; };
+
+    void clear();
+    void build_points();
+    void build_tree(size_t lo, size_t hi);
+    void search(size_t lo, size_t hi, const double q[3], size_t k, std::vector<std::pair<double, uint32_t>>& heap) const;
+
+    std::vector<Site> sites_;            // ordered by site_id
+    std::vector<uint32_t> slot_of_;      // site_id -> index in sites_ (UINT32_MAX if absent)
+    std::vector<uint32_t> rows_;         // row ids grouped by site, time-ordered
+    std::vector<Point> tree_;            // implicit k-d tree: median of [lo, hi) at the midpoint
+    std::vector<uint8_t> axis_;          // split axis of the node at each midpoint
+};
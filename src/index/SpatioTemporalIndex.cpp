@@ -0,0 +1,98 @@
+#include "index/SpatioTemporalIndex.h"
+#include "index/SiteIndex.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double kKmPerDegree = 111.19492664455873;   // great circle, mean Earth radius
+static constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+uint32_t SpatioTemporalIndex::col_of(double lon) {
+    double c = std::floor((lon + 180.0) / kCellDegrees);
+    return (uint32_t)std::min(std::max(c, 0.0), (double)(kCols - 1));
+}
+
+uint32_t SpatioTemporalIndex::row_of(double lat) {
+    double r = std::floor((lat + 90.0) / kCellDegrees);
+    return (uint32_t)std::min(std::max(r, 0.0), (double)(kRows - 1));
+}
+
+void SpatioTemporalIndex::build(const FireRecords& records, const SiteTable& sites) {
+    // Keys in parallel, then one parallel radix sort of (key, row) pairs
+    const long long n = (long long)records.size();
+    std::vector<std::pair<uint64_t, uint32_t>> pairs((size_t)n);
+    std::vector<char> keep((size_t)n, 0);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; ++i) {
+        const FireRecord& r = records[i];
+        const SiteRecord& site = sites[r.site_id];
+        if (r.utc_minutes < 0 || std::isnan(site.latitude) || std::isnan(site.longitude)) continue;
+        pairs[i] = {key_of(r.utc_minutes / 60, row_of(site.latitude), col_of(site.longitude)), (uint32_t)i};
+        keep[i] = 1;
+    }
+    size_t m = 0;
+    for (size_t i = 0; i < (size_t)n; ++i) if (keep[i]) pairs[m++] = pairs[i];
+    pairs.resize(m);
+    parallel_radix_sort(pairs);
+
+    keys_.resize(m);
+    rows_.resize(m);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)m; ++i) {
+        keys_[i] = pairs[i].first;
+        rows_[i] = pairs[i].second;
+    }
+}
+
+std::vector<uint32_t> SpatioTemporalIndex::findNear(const FireRecords& records, const SiteTable& sites, double lat, double lon,
+                                                    double radiusKm, int32_t utcFrom, int32_t utcTo) const {
+    std::vector<uint32_t> out;
+    if (keys_.empty() || radiusKm < 0 || utcFrom > utcTo || std::isnan(lat) || std::isnan(lon)) return out;
+
+    // Bounding box of the circle; longitude span widens with latitude and
+    // covers everything near the poles. Wrapping spans split in two ranges.
+    const double dLat = radiusKm / kKmPerDegree;
+    const double latLo = std::max(-90.0, lat - dLat), latHi = std::min(90.0, lat + dLat);
+    const double cosLat = std::min(std::cos(latLo * kDegToRad), std::cos(latHi * kDegToRad));
+    std::vector<std::pair<uint32_t, uint32_t>> colRanges;
+    if (latLo <= -90.0 || latHi >= 90.0 || cosLat <= 1e-9 || dLat / cosLat >= 180.0) {
+        colRanges.push_back({0, kCols - 1});
+    } else {
+        const double dLon = dLat / cosLat;
+        double lonLo = lon - dLon, lonHi = lon + dLon;
+        if (lonLo < -180.0) {
+            colRanges.push_back({col_of(lonLo + 360.0), kCols - 1});
+            lonLo = -180.0;
+        }
+        if (lonHi >= 180.0) {
+            colRanges.push_back({0, col_of(lonHi - 360.0)});
+            lonHi = 180.0;
+        }
+        colRanges.push_back({col_of(lonLo), col_of(lonHi)});
+    }
+    const uint32_t r0 = row_of(latLo), r1 = row_of(latHi);
+
+    // Hours present in the data only: start from the first key at or after the window
+    const int64_t h0 = std::max<int64_t>(0, utcFrom / 60), h1 = std::max<int64_t>(0, utcTo / 60);
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key_of(h0, 0, 0));
+    while (it != keys_.end()) {
+        const int64_t h = (int64_t)(*it >> 24);
+        if (h > h1) break;
+        for (uint32_t row = r0; row <= r1; ++row) {
+            for (const auto& [c0, c1] : colRanges) {
+                auto lo = std::lower_bound(it, keys_.end(), key_of(h, row, c0));
+                auto hi = std::upper_bound(lo, keys_.end(), key_of(h, row, c1));
+                for (auto k = lo; k != hi; ++k) {
+                    const uint32_t id = rows_[k - keys_.begin()];
+                    const FireRecord& r = records[id];
+                    if (r.utc_minutes < utcFrom || r.utc_minutes > utcTo) continue;
+                    const SiteRecord& site = sites[r.site_id];
+                    if (SiteIndex::haversineKm(lat, lon, site.latitude, site.longitude) <= radiusKm) out.push_back(id);
+                }
+            }
+        }
+        it = std::lower_bound(it, keys_.end(), key_of(h + 1, 0, 0));
+    }
+    return out;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "../utility/Records.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Time-partitioned grid over (utc hour, latitude, longitude). Rows are
+// sorted by the composite key hour | cell row | cell column over 0.1 degree
+// cells, so the cells of one grid row within one hour are a contiguous key
+// range. A radius query touches hours x grid rows of its bounding box, then
+// refines each candidate by exact time and haversine distance.
+class SpatioTemporalIndex {
+public:
+    static constexpr double kCellDegrees = 0.1;
+
+    void build(const FireRecords& records, const SiteTable& sites);
+
+    // Row ids within radiusKm of (lat, lon) with utcFrom <= utc_minutes <= utcTo.
+    std::vector<uint32_t> findNear(const FireRecords& records, const SiteTable& sites, double lat, double lon, double radiusKm,
+                                   int32_t utcFrom, int32_t utcTo) const;
+
+    size_t memoryBytes() const { return keys_.capacity() * sizeof(uint64_t) + rows_.capacity() * sizeof(uint32_t); }
+
+private:
+    static constexpr uint32_t kCols = 3600;   // 360 / kCellDegrees
+    static constexpr uint32_t kRows = 1800;   // 180 / kCellDegrees
+
+    static uint32_t col_of(double lon);
+    static uint32_t row_of(double lat);
+    static uint64_t key_of(int64_t hour, uint32_t row, uint32_t col) {
+        return ((uint64_t)hour << 24) | ((uint64_t)row << 12) | col;
+    }
+
+    std::vector<uint64_t> keys_;   // sorted
+    std::vector<uint32_t> rows_;   // row id per key
+};
@@ -0,0 +1,192 @@
+#include "index/TilePyramid.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+// -------- TileStats --------
+void TileStats::add(const FireRecord& r) {
+    value_sum += r.numericValue;
+    value_max = std::max(value_max, (float)r.numericValue);
+    ++count;
+    if (r.aqi >= 0) {
+        aqi_sum += r.aqi;
+        ++aqi_count;
+        aqi_max = std::max(aqi_max, r.aqi);
+    }
+}
+
+void TileStats::merge(const TileStats& o) {
+    value_sum += o.value_sum;
+    value_max = std::max(value_max, o.value_max);
+    count += o.count;
+    aqi_sum += o.aqi_sum;
+    aqi_count += o.aqi_count;
+    aqi_max = std::max(aqi_max, o.aqi_max);
+}
+
+// -------- cell math --------
+uint32_t TilePyramid::cellX(double lon, int level) {
+    const double cells = (double)(1u << level);
+    double x = std::floor((lon + 180.0) / 360.0 * cells);
+    return (uint32_t)std::min(std::max(x, 0.0), cells - 1);
+}
+
+uint32_t TilePyramid::cellY(double lat, int level) {
+    const double cells = (double)(1u << level);
+    double y = std::floor((lat + 90.0) / 180.0 * cells);
+    return (uint32_t)std::min(std::max(y, 0.0), cells - 1);
+}
+
+uint32_t TilePyramid::morton(uint32_t x, uint32_t y) {
+    auto spread = [](uint32_t v) {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+void TilePyramid::unmorton(uint32_t code, uint32_t& x, uint32_t& y) {
+    auto compact = [](uint32_t v) {
+        v &= 0x55555555;
+        v = (v | (v >> 1)) & 0x33333333;
+        v = (v | (v >> 2)) & 0x0F0F0F0F;
+        v = (v | (v >> 4)) & 0x00FF00FF;
+        v = (v | (v >> 8)) & 0x0000FFFF;
+        return v;
+    };
+    x = compact(code);
+    y = compact(code >> 1);
+}
+
+bool TilePyramid::make_key(const FireRecord& r, const SiteRecord& site, int level, uint64_t& key) {
+    if (r.utc_minutes < 0 || std::isnan(site.latitude) || std::isnan(site.longitude)) return false;
+    const int64_t hour = r.utc_minutes / 60;
+    if (hour >= (1 << 24)) return false;
+    key = prefix(r.parameter_id, hour) | morton(cellX(site.longitude, level), cellY(site.latitude, level));
+    return true;
+}
+
+// -------- build / append --------
+void TilePyramid::build(const FireRecords& records, const SiteTable& sites) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int li = 0; li < (int)kLevels; ++li) {
+        const int level = kMinLevel + li;
+        std::unordered_map<uint64_t, TileStats> acc;
+        acc.reserve(records.size() >> (2 * (kMaxLevel - level) / 3));
+        uint64_t key = 0;
+        for (const auto& r : records) {
+            if (make_key(r, sites[r.site_id], level, key)) acc[key].add(r);
+        }
+        tiles_[li].assign(acc.begin(), acc.end());
+        parallel_radix_sort(tiles_[li]);
+        tiles_[li].shrink_to_fit();
+        pending_[li].clear();
+    }
+}
+
+void TilePyramid::append(const FireRecord& record, const SiteRecord& site) {
+    uint64_t key = 0;
+    for (size_t li = 0; li < kLevels; ++li) {
+        if (!make_key(record, site, kMinLevel + (int)li, key)) return;
+        // Existing tile: update in place; new tile: side table until merged
+        auto it = std::lower_bound(tiles_[li].begin(), tiles_[li].end(), key,
+            [](const Entry& e, uint64_t k) { return e.first < k; });
+        if (it != tiles_[li].end() && it->first == key) it->second.add(record);
+        else pending_[li][key].add(record);
+        if (pending_[li].size() >= kPendingLimit) merge_pending(li);
+    }
+}
+
+void TilePyramid::merge_pending(size_t li) {
+    std::vector<Entry> fresh(pending_[li].begin(), pending_[li].end());
+    parallel_radix_sort(fresh);
+    std::vector<Entry> merged;
+    merged.reserve(tiles_[li].size() + fresh.size());
+    std::merge(tiles_[li].begin(), tiles_[li].end(), fresh.begin(), fresh.end(), std::back_inserter(merged),
+        [](const Entry& a, const Entry& b) { return a.first < b.first; });
+    tiles_[li] = std::move(merged);
+    pending_[li].clear();
+}
+
+// -------- query --------
+std::vector<TilePyramid::Tile> TilePyramid::query(int level, uint16_t parameterId,
+                                                  double latMin, double latMax, double lonMin, double lonMax,
+                                                  int32_t utcFrom, int32_t utcTo) const {
+    if (level < kMinLevel || level > kMaxLevel || latMin > latMax || lonMin > lonMax || utcFrom > utcTo) return {};
+    const size_t li = (size_t)(level - kMinLevel);
+    const uint32_t x0 = cellX(lonMin, level), x1 = cellX(lonMax, level);
+    const uint32_t y0 = cellY(latMin, level), y1 = cellY(latMax, level);
+    const uint32_t m0 = morton(x0, y0), m1 = morton(x1, y1);
+    const int64_t h0 = std::max<int64_t>(0, utcFrom / 60);
+    const int64_t h1 = std::min<int64_t>((1 << 24) - 1, utcTo / 60);
+    if (h1 < h0) return {};   // range entirely before 1970 or past the hour field
+
+    std::map<uint32_t, TileStats> cells;   // keyed by y << 16 | x for (y, x) order
+    auto take = [&](uint64_t key, const TileStats& stats) {
+        uint32_t x = 0, y = 0;
+        unmorton((uint32_t)(key & 0xFFFFF), x, y);
+        if (x < x0 || x > x1 || y < y0 || y > y1) return;
+        cells[(y << 16) | x].merge(stats);
+    };
+
+    const auto& tiles = tiles_[li];
+    auto byKey = [](const Entry& e, uint64_t k) { return e.first < k; };
+    // One seek to (h0, m0), then walk; an hour's run outside [m0, m1] seeks
+    // ahead within the remaining tiles, so cost follows hours with tiles
+    const uint64_t last = prefix(parameterId, h1) | m1;
+    auto it = std::lower_bound(tiles.begin(), tiles.end(), prefix(parameterId, h0) | m0, byKey);
+    while (it != tiles.end() && it->first <= last) {
+        const uint32_t code = (uint32_t)(it->first & 0xFFFFF);
+        const int64_t h = (int64_t)((it->first >> 20) & 0xFFFFFF);
+        if (code < m0) {
+            it = std::lower_bound(it, tiles.end(), prefix(parameterId, h) | m0, byKey);
+        } else if (code > m1) {
+            // h < h1 here, since last ends hour h1
+            it = std::lower_bound(it, tiles.end(), prefix(parameterId, h + 1) | m0, byKey);
+        } else {
+            take(it->first, it->second);
+            ++it;
+        }
+    }
+    for (const auto& [key, stats] : pending_[li]) {
+        const int64_t h = (int64_t)((key >> 20) & 0xFFFFFF);
+        if ((uint16_t)(key >> 44) == parameterId && h >= h0 && h <= h1) take(key, stats);
+    }
+
+    const double cellsPerSide = (double)(1u << level);
+    std::vector<Tile> out;
+    out.reserve(cells.size());
+    for (const auto& [yx, stats] : cells) {
+        Tile t;
+        t.x = yx & 0xFFFF;
+        t.y = yx >> 16;
+        t.lon_min = -180.0 + 360.0 * t.x / cellsPerSide;
+        t.lon_max = -180.0 + 360.0 * (t.x + 1) / cellsPerSide;
+        t.lat_min = -90.0 + 180.0 * t.y / cellsPerSide;
+        t.lat_max = -90.0 + 180.0 * (t.y + 1) / cellsPerSide;
+        t.stats = stats;
+        out.push_back(t);
+    }
+    return out;
+}
+
+size_t TilePyramid::tileCount() const {
+    size_t n = 0;
+    for (size_t li = 0; li < kLevels; ++li) n += tiles_[li].size() + pending_[li].size();
+    return n;
+}
+
+size_t TilePyramid::memoryBytes() const {
+    size_t bytes = 0;
+    for (size_t li = 0; li < kLevels; ++li) {
+        bytes += tiles_[li].capacity() * sizeof(Entry);
+        bytes += pending_[li].size() * (sizeof(Entry) + sizeof(void*)) + pending_[li].bucket_count() * sizeof(void*);
+    }
+    return bytes;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "../utility/Records.h"
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Pre-aggregated statistics for one (parameter, hour, cell).
+struct TileStats {
+    double value_sum = 0.0;
+    float value_max = -std::numeric_limits<float>::infinity();
+    uint32_t count = 0;
+    int32_t aqi_sum = 0;        // over readings with a valid AQI (>= 0)
+    uint32_t aqi_count = 0;
+    int16_t aqi_max = -1;
+
+    void add(const FireRecord& r);
+    void merge(const TileStats& o);
+
+    double valueMean() const { return count ? value_sum / count : 0.0; }
+    double aqiMean() const { return aqi_count ? (double)aqi_sum / aqi_count : 0.0; }
+};
+
+// Heatmap tile pyramid over (latitude, longitude, utc_minutes). Level L splits
+// the globe into 2^L x 2^L equirectangular cells; every level from kMinLevel
+// to kMaxLevel is kept, bucketed by hour and parameter. Viewport queries read
+// only tiles, never raw records.
+class TilePyramid {
+public:
+    static constexpr int kMinLevel = 2;
+    static constexpr int kMaxLevel = 10;
+
+    struct Tile {
+        uint32_t x = 0, y = 0;      // cell column (longitude) and row (latitude)
+        double lat_min = 0, lat_max = 0, lon_min = 0, lon_max = 0;
+        TileStats stats;
+    };
+
+    // Replaces the contents; levels build in parallel.
+    void build(const FireRecords& records, const SiteTable& sites);
+
+    // Incremental update for newly appended records. Not safe concurrently
+    // with query(); small batches go to a side table merged on demand.
+    void append(const FireRecord& record, const SiteRecord& site);
+
+    // Non-empty cells at `level` intersecting the viewport, with stats merged
+    // over every hour bucket overlapping [utcFrom, utcTo]. Sorted by (y, x).
+    std::vector<Tile> query(int level, uint16_t parameterId,
+                            double latMin, double latMax, double lonMin, double lonMax,
+                            int32_t utcFrom, int32_t utcTo) const;
+
+    size_t tileCount() const;
+    size_t memoryBytes() const;
+
+    // Cell coordinates of a point at `level` (clamped to the grid).
+    static uint32_t cellX(double lon, int level);
+    static uint32_t cellY(double lat, int level);
+
+private:
+    using Entry = std::pair<uint64_t, TileStats>;
+    static constexpr size_t kLevels = kMaxLevel - kMinLevel + 1;
+    static constexpr size_t kPendingLimit = 1u << 16;
+
+    // Key: parameter (16 bits) | hour (24 bits) | Morton(x, y) (2 * level bits).
+    // One (parameter, hour) is a contiguous run, and a viewport's cells fall
+    // inside [Morton(xmin, ymin), Morton(xmax, ymax)] within that run.
+    static bool make_key(const FireRecord& r, const SiteRecord& site, int level, uint64_t& key);
+    static uint64_t prefix(uint16_t parameterId, int64_t hour) { return ((uint64_t)parameterId << 44) | ((uint64_t)hour << 20); }
+    static uint32_t morton(uint32_t x, uint32_t y);
+    static void unmorton(uint32_t code, uint32_t& x, uint32_t& y);
+
+    void merge_pending(size_t levelIdx);
+
+    std::vector<Entry> tiles_[kLevels];                        // sorted by key
+    std::unordered_map<uint64_t, TileStats> pending_[kLevels];  // appends since the last merge
+};
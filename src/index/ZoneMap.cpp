@@ -0,0 +1,48 @@
+#include "index/ZoneMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void ZoneMap::build(const FireRecords& records, const SiteTable& sites) {
+    rows_ = records.size();
+    blocks_ = (rows_ + kBlockRows - 1) / kBlockRows;
+    const Range empty{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    for (auto& field : ranges_) field.assign(blocks_, empty);
+
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < (long long)blocks_; ++b) {
+        Range r[(size_t)Field::Count];
+        std::fill(std::begin(r), std::end(r), empty);
+        auto widen = [&](Field f, double v) {
+            if (std::isnan(v)) return;
+            Range& z = r[(size_t)f];
+            z.min = std::min(z.min, v);
+            z.max = std::max(z.max, v);
+        };
+        for (size_t i = blockBegin((size_t)b); i < blockEnd((size_t)b); ++i) {
+            const FireRecord& rec = records[i];
+            const SiteRecord& site = sites[rec.site_id];
+            widen(Field::Value, rec.numericValue);
+            widen(Field::UTCMinutes, rec.utc_minutes);
+            widen(Field::AQI, rec.aqi);
+            widen(Field::ParameterId, rec.parameter_id);
+            widen(Field::Latitude, site.latitude);
+            widen(Field::Longitude, site.longitude);
+        }
+        for (size_t f = 0; f < (size_t)Field::Count; ++f) ranges_[f][b] = r[f];
+    }
+}
+
+double ZoneMap::prunedFraction(Field field, double lo, double hi) const {
+    if (blocks_ == 0) return 0.0;
+    size_t pruned = 0;
+    for (size_t b = 0; b < blocks_; ++b) pruned += mayContain(field, b, lo, hi) ? 0 : 1;
+    return (double)pruned / blocks_;
+}
+
+size_t ZoneMap::memoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& field : ranges_) bytes += field.capacity() * sizeof(Range);
+    return bytes;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "../utility/Records.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-block min/max ("zone map") of the range-filterable fire columns. A
+// range predicate skips every block whose [min, max] misses it; the blocks
+// left are scanned in order, so results do not change. Pruning depends on
+// the physical order: clustered rows give narrow zones.
+class ZoneMap {
+public:
+    static constexpr size_t kBlockRows = 4096;
+
+    enum class Field { Value, UTCMinutes, AQI, ParameterId, Latitude, Longitude, Count };
+
+    // Replaces the contents; blocks build in parallel. NaNs are ignored, so
+    // an all-NaN block matches nothing.
+    void build(const FireRecords& records, const SiteTable& sites);
+
+    size_t blocks() const { return blocks_; }
+    size_t rows() const { return rows_; }
+
+    // Rows [begin, end) of a block
+    size_t blockBegin(size_t block) const { return block * kBlockRows; }
+    size_t blockEnd(size_t block) const { return std::min(rows_, (block + 1) * kBlockRows); }
+
+    // Whether the block may hold rows with the field in [lo, hi]
+    bool mayContain(Field field, size_t block, double lo, double hi) const {
+        const Range& r = ranges_[(size_t)field][block];
+        return r.min <= hi && r.max >= lo;
+    }
+
+    // Share of blocks the predicate rules out
+    double prunedFraction(Field field, double lo, double hi) const;
+
+    size_t memoryBytes() const;
+
+private:
+    struct Range { double min, max; };
+
+    size_t rows_ = 0;
+    size_t blocks_ = 0;
+    std::vector<Range> ranges_[(size_t)Field::Count];
+};
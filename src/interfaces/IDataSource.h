@@ -33,7 +33,18 @@ enum class Column {
 
     // WorldBank country identifiers (dictionary ids)
     WB_CountryNameId,
-    WB_CountryCodeId
+    WB_CountryCodeId,
+
+    // Dictionary-encoded strings. min/max are names compared bytewise; ids
+    // are assigned in name order, so these run as id range predicates. A
+    // prefix P is the range [P, P + "\xff"] (0xFF never occurs in UTF-8).
+    ParameterName,
+    UnitName,
+    SiteName,
+    AgencyName,
+    AqsName,
+    WB_CountryName,
+    WB_CountryCode
 };
 
 class IDataSource {
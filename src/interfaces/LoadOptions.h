@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include "IDataSource.h"
+
+// AirNow CSV fields, by position in a row
+enum class FireField : uint32_t { Latitude, Longitude, Utc, Parameter, Value, Unit, RawValue, Aqi, Category, SiteName, Agency, Aqs };
+
+constexpr uint32_t fire_field_bit(FireField f) { return 1u << (uint32_t)f; }
+constexpr uint32_t kAllFireFields = (1u << ((uint32_t)FireField::Aqs + 1)) - 1;
+
+// CSV fields a query on col reads (Fire). Latitude and longitude are always
+// parsed, so they and the WorldBank columns need none.
+inline uint32_t fire_fields_for(Column col) {
+    switch (col) {
+        case Column::Value:         return fire_field_bit(FireField::Value);
+        case Column::RawValue:      return fire_field_bit(FireField::RawValue);
+        case Column::AQI:           return fire_field_bit(FireField::Aqi);
+        case Column::Category:      return fire_field_bit(FireField::Category);
+        case Column::Year:
+        case Column::UTCMinutes:    return fire_field_bit(FireField::Utc);
+        case Column::ParameterId:
+        case Column::ParameterName: return fire_field_bit(FireField::Parameter);
+        case Column::UnitId:
+        case Column::UnitName:      return fire_field_bit(FireField::Unit);
+        case Column::SiteId:
+        case Column::SiteName:      return fire_field_bit(FireField::SiteName);
+        case Column::AgencyId:
+        case Column::AgencyName:    return fire_field_bit(FireField::Agency);
+        case Column::AqsId:
+        case Column::AqsName:       return fire_field_bit(FireField::Aqs);
+        default:                    return 0;
+    }
+}
+
+// Tuning knobs shared by all data-source loaders.
+struct LoadOptions {
+    // Split headerless files larger than this into line-aligned chunks that
+    // load as independent tasks. 0 disables splitting.
+    uint64_t chunkBytes = 0;
+
+    // Ordered secondary indexes used by findByRange, findMin and findMax
+    // when present. SkipList: numericValue (map source). BTree and
+    // Eytzinger: numericValue, utc_minutes and aqi (vector source).
+    // Cracking: adaptive indexes on the same columns, refined by each
+    // findByRange instead of built at load (vector source). BitSliced:
+    // bit-sliced numericValue and raw_value, for range filters only.
+    enum class OrderedIndex { None, SkipList, BTree, Eytzinger, Cracking, BitSliced };
+    OrderedIndex orderedIndex = OrderedIndex::None;
+
+    // Build the heatmap tile pyramid (Fire, vector source) after load.
+    bool heatmap = false;
+
+    // Build the (site, parameter, hour) hash index for point lookups (Fire,
+    // vector source) at load instead of on the first lookup.
+    bool pointIndex = false;
+
+    // Physical row order after load (Fire, vector source). ParameterSiteTime
+    // sorts by (parameter_id, site_id, utc_minutes); ZOrder interleaves
+    // quantized latitude, longitude and hour. None keeps load order.
+    enum class Clustering { None, ParameterSiteTime, ZOrder };
+    Clustering clustering = Clustering::None;
+
+    // Cap on the columns the raw source keeps parsed, in bytes; past it the
+    // least recently used ones are dropped and re-parsed when needed. 0 = no cap.
+    uint64_t rawCacheBytes = 0;
+
+    // Projection (Fire; vector and map sources): the fields loaded, as
+    // fire_field_bit()s. Other fields are still delimited but never copied,
+    // converted or dictionary-encoded; they read back as defaults (NaN
+    // values, AQI -999, empty names) and findByRange on them finds nothing.
+    // Latitude and longitude are always loaded (row checks, site dimension).
+    uint32_t fireFields = kAllFireFields;
+    bool loadsColumn(Column col) const { return (fire_fields_for(col) & ~fireFields) == 0; }
+};
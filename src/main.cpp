@@ -1,41 +1,96 @@
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#include "bench/Benchmarks.h"
 #include "factory/DataSourceFactory.h"
 #include "interfaces/IDataSource.h"
+#include "implementations/InstrumentedDataSource.h"
+#include "implementations/MapDataSource.h"
+#include "implementations/VectorDataSource.h"
+#include "utility/Clustering.h"
+#include "utility/GeoShapes.h"
+#include "utility/Metrics.h"
 
 using clk = std::chrono::high_resolution_clock;
 
 struct Cli {
     std::string csvPath;
-    std::string dsType;      // vector | map
+    std::string dsType;      // vector | map | raw
     std::string colName = "Population";  // default column to query
     std::string minVal = "0";
     std::string maxVal = "1e18";
     int year = 2020;
     int threads = 1;
+    std::string metricsOut;  // Prometheus text file written after the run
+    int metricsPort = 0;     // serve /metrics on 127.0.0.1 while running
+    int metricsLinger = 0;   // seconds to keep serving after the run
+    LoadOptions load;
+    std::string bench;       // run a micro-benchmark instead of the query suite
+    std::string within;      // GeoJSON/WKT file: count readings inside each shape (vector)
+    std::string columns;     // comma-separated columns to load (projection)
+    std::string workload;    // file of range queries, run after the suite; projects the load
+};
+
+// One workload line: COLUMN [MIN MAX]
+struct WorkloadQuery {
+    Column col;
+    std::string minVal, maxVal;   // empty: the column is loaded, not queried
 };
 
 static void usage(const char* prog) {
     std::cerr << "Usage: " << prog
-              << " <csv_or_dir> <vector|map> [--col COLUMN] [--min X] [--max Y] [--year N] [--threads N]\n"
+              << " <csv_or_dir> <vector|map|raw> [--col COLUMN] [--min X] [--max Y] [--prefix P] [--year N] [--threads N]\n"
+              << "       [--metrics-out FILE] [--metrics-port N] [--metrics-linger SECONDS]\n"
+              << "       [--chunk-mb N]   split headerless files larger than N MiB into parallel chunks\n"
+              << "       [--index none|skiplist|btree|eytzinger|cracking|bitsliced]   skiplist: Value (map); btree, eytzinger, cracking: Value/UTCMinutes/AQI;\n"
+              << "                 bitsliced: Value/RawValue (vector)\n"
+              << "       [--cluster none|parameter-site-time|zorder]   sort fire rows after load (vector)\n"
+              << "       [--heatmap]   build heatmap tiles (levels 2-10 x hour) after load (vector)\n"
+              << "       [--point-index]   build the (site, parameter, hour) lookup hash index at load (vector)\n"
+              << "       [--raw-cache-mb N]   raw: keep at most N MiB of parsed columns (least recently used dropped)\n"
+              << "       [--within FILE]   readings inside each polygon of a GeoJSON/WKT file (vector)\n"
+              << "       [--bench NAME]   micro-benchmark over the loaded data (vector; map: skiplist), sweeping 1..--threads\n"
+              << "       [--columns C1,C2,...]   load only the fields these columns need (vector, map; --col, Value and Year always)\n"
+              << "       [--workload FILE]   lines COLUMN [MIN MAX]: range queries run after the suite; projects the load like --columns\n"
               << "Columns:\n"
-              << "  WorldBank: Population, Year\n"
+              << "  WorldBank: Population, Year, WB_CountryName, WB_CountryCode\n"
               << "  AirNow:   Value, RawValue, AQI, Category, Latitude, Longitude, UTCMinutes, ParameterId, UnitId, SiteId, AgencyId, AqsId\n"
+              << "            ParameterName, UnitName, SiteName, AgencyName, AqsName (--min/--max names, or --prefix P)\n"
               << "Example:\n"
               << "  " << prog << " Data/2020-fire/data vector --col Value --min 0 --max 100 --threads 8\n"
               << "  " << prog << " Data/worldbank/worldbank.csv vector --col Population --min 1e7 --max 1e8 --year 2019 --threads 4\n";
 }
 
+static LoadOptions::OrderedIndex parseOrderedIndex(const std::string& name) {
+    if (name == "none")     return LoadOptions::OrderedIndex::None;
+    if (name == "skiplist") return LoadOptions::OrderedIndex::SkipList;
+    if (name == "btree")    return LoadOptions::OrderedIndex::BTree;
+    if (name == "eytzinger") return LoadOptions::OrderedIndex::Eytzinger;
+    if (name == "cracking") return LoadOptions::OrderedIndex::Cracking;
+    if (name == "bitsliced") return LoadOptions::OrderedIndex::BitSliced;
+    throw std::runtime_error("Unknown index: " + name);
+}
+
+static LoadOptions::Clustering parseClustering(const std::string& name) {
+    if (name == "none")                return LoadOptions::Clustering::None;
+    if (name == "parameter-site-time") return LoadOptions::Clustering::ParameterSiteTime;
+    if (name == "zorder")              return LoadOptions::Clustering::ZOrder;
+    throw std::runtime_error("Unknown clustering: " + name);
+}
+
 static bool parse_cli(int argc, char* argv[], Cli& cli) {
     if (argc < 3) return false;
     cli.csvPath = argv[1];
@@ -49,8 +104,22 @@ static bool parse_cli(int argc, char* argv[], Cli& cli) {
         if (k == "--col") cli.colName = next();
         else if (k == "--min") cli.minVal = next();
         else if (k == "--max") cli.maxVal = next();
+        else if (k == "--prefix") { cli.minVal = next(); cli.maxVal = cli.minVal + "\xff"; }
         else if (k == "--year") cli.year = std::stoi(next());
         else if (k == "--threads") cli.threads = std::stoi(next());
+        else if (k == "--metrics-out") cli.metricsOut = next();
+        else if (k == "--metrics-port") cli.metricsPort = std::stoi(next());
+        else if (k == "--metrics-linger") cli.metricsLinger = std::stoi(next());
+        else if (k == "--chunk-mb") cli.load.chunkBytes = (uint64_t)(std::stod(next()) * 1024 * 1024);
+        else if (k == "--index") cli.load.orderedIndex = parseOrderedIndex(next());
+        else if (k == "--cluster") cli.load.clustering = parseClustering(next());
+        else if (k == "--heatmap") cli.load.heatmap = true;
+        else if (k == "--point-index") cli.load.pointIndex = true;
+        else if (k == "--raw-cache-mb") cli.load.rawCacheBytes = (uint64_t)(std::stod(next()) * 1024 * 1024);
+        else if (k == "--bench") cli.bench = next();
+        else if (k == "--within") cli.within = next();
+        else if (k == "--columns") cli.columns = next();
+        else if (k == "--workload") cli.workload = next();
         else throw std::runtime_error("Unknown flag: " + k);
     }
     return true;
@@ -74,13 +143,53 @@ static Column parseColumn(const std::string& name) {
         {"AgencyId",    Column::AgencyId},
         {"AqsId",       Column::AqsId},
         {"WB_CountryNameId", Column::WB_CountryNameId},
-        {"WB_CountryCodeId", Column::WB_CountryCodeId}
+        {"WB_CountryCodeId", Column::WB_CountryCodeId},
+        {"ParameterName", Column::ParameterName},
+        {"UnitName",    Column::UnitName},
+        {"SiteName",    Column::SiteName},
+        {"AgencyName",  Column::AgencyName},
+        {"AqsName",     Column::AqsName},
+        {"WB_CountryName", Column::WB_CountryName},
+        {"WB_CountryCode", Column::WB_CountryCode}
     };
     auto it = map.find(name);
     if (it == map.end()) throw std::runtime_error("Unknown column: " + name);
     return it->second;
 }
 
+// Workload file: one query per line, COLUMN [MIN MAX] separated by spaces or
+// commas; blank lines and lines starting with # are skipped
+static std::vector<WorkloadQuery> load_workload(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open workload " + path);
+    std::vector<WorkloadQuery> queries;
+    std::string line;
+    for (size_t lineNo = 1; std::getline(in, line); ++lineNo) {
+        for (char& c : line) if (c == ',') c = ' ';
+        std::istringstream tokens(line);
+        std::string name;
+        if (!(tokens >> name) || name[0] == '#') continue;
+        WorkloadQuery q{parseColumn(name), "", ""};
+        if (tokens >> q.minVal && !(tokens >> q.maxVal)) {
+            throw std::runtime_error("workload " + path + ":" + std::to_string(lineNo) + ": expected COLUMN [MIN MAX]");
+        }
+        queries.push_back(q);
+    }
+    return queries;
+}
+
+// Fire fields a session reads: the query suite's own (col, Value, Year),
+// the --columns list and the workload's columns
+static uint32_t projection(const Cli& cli, Column col, const std::vector<WorkloadQuery>& workload) {
+    uint32_t fields = fire_fields_for(col) | fire_fields_for(Column::Value) | fire_fields_for(Column::Year);
+    std::istringstream names(cli.columns);
+    for (std::string name; std::getline(names, name, ',');) {
+        if (!name.empty()) fields |= fire_fields_for(parseColumn(name));
+    }
+    for (const auto& q : workload) fields |= fire_fields_for(q.col);
+    return fields;
+}
+
 static std::string mode_str(int threads) {
     return threads > 1 ? "parallel" : "serial";
 }
@@ -143,6 +252,19 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: " << e.what() << "\n"; usage(argv[0]); return 2;
     }
 
+    Column col = Column::Population;
+    try { col = parseColumn(cli.colName); }
+    catch (const std::exception& e) {
+        std::cerr << "Warning: " << e.what() << " defaulting to Population\n";
+    }
+    std::vector<WorkloadQuery> workload;
+    try {
+        if (!cli.workload.empty()) workload = load_workload(cli.workload);
+        if (!cli.columns.empty() || !cli.workload.empty()) cli.load.fireFields = projection(cli, col, workload);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n"; return 2;
+    }
+
 #ifdef _OPENMP
     if (cli.threads < 1) cli.threads = 1;
     omp_set_num_threads(cli.threads);
@@ -150,9 +272,38 @@ int main(int argc, char* argv[]) {
     cli.threads = 1;
 #endif
 
+    if (!cli.bench.empty()) {
+        // Micro-benchmarks run over the chosen source's loaded records
+        if (cli.dsType != "vector" && cli.dsType != "map") {
+            std::cerr << "Error: --bench needs the vector or map data source\n";
+            return 2;
+        }
+        const auto names = Benchmarks::names(cli.dsType);
+        if (std::find(names.begin(), names.end(), cli.bench) == names.end()) {
+            std::cerr << "Error: unknown " << cli.dsType << " benchmark " << cli.bench << " (available:";
+            for (const auto& name : names) std::cerr << " " << name;
+            std::cerr << ")\n";
+            return 2;
+        }
+        if (cli.dsType == "map") {
+            MapDataSource data(cli.csvPath, cli.load);
+            Benchmarks::run(cli.bench, data, cli.threads);
+        } else {
+            VectorDataSource data(cli.csvPath, cli.load);
+            Benchmarks::run(cli.bench, data, cli.threads);
+        }
+        return 0;
+    }
+
+    const bool metricsEnabled = !cli.metricsOut.empty() || cli.metricsPort > 0;
+    auto& metrics = MetricsRegistry::instance();
+    if (cli.metricsPort > 0 && !metrics.serve(cli.metricsPort)) {
+        std::cerr << "Warning: could not serve metrics on port " << cli.metricsPort << "\n";
+    }
+
     // Measure loading time
     auto load_t0 = clk::now();
-    auto ds = DataSourceFactory::create(cli.dsType, cli.csvPath);
+    auto ds = DataSourceFactory::create(cli.dsType, cli.csvPath, cli.load);
     auto load_t1 = clk::now();
     double load_ms = std::chrono::duration<double, std::milli>(load_t1 - load_t0).count();
     
@@ -160,22 +311,76 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: invalid data source type " << cli.dsType << "\n";
         return 1;
     }
+    IDataSource* base = ds.get();   // unwrapped, for vector-only queries
+    if (metricsEnabled) {
+        metrics.gauge("mini1_load_seconds", "Wall time of the last load", "impl=\"" + cli.dsType + "\"")
+            .set(load_ms / 1000.0);
+        ds = std::make_unique<InstrumentedDataSource>(std::move(ds), cli.dsType);
+    }
 
     // dataset label from filename
     std::string dataset = cli.csvPath;
     size_t pos = dataset.find_last_of("/\\");
     if (pos != std::string::npos) dataset = dataset.substr(pos + 1);
 
-    Column col = Column::Population;
-    try { col = parseColumn(cli.colName); }
-    catch (const std::exception& e) {
-        std::cerr << "Warning: " << e.what() << " defaulting to Population\n";
-    }
-
     std::cout << "dataset,impl,mode,stage,operation,column,arg,result,count,ms\n";
     std::cout << dataset << "," << cli.dsType << "," << mode_str(cli.threads)
               << ",load,load_data,,,," << "," << load_ms << "\n";
+    // Load imbalance of the parallel parse phase (last minus median thread finish)
+    double tail_ms = 1000.0 * metrics.gauge("mini1_load_tail_seconds",
+        "Parse phase: last thread finish minus median thread finish", "impl=\"" + cli.dsType + "\"").value();
+    std::cout << dataset << "," << cli.dsType << "," << mode_str(cli.threads)
+              << ",load,load_tail,,,," << "," << tail_ms << "\n";
+    auto* clustered = dynamic_cast<VectorDataSource*>(base);
+    if (cli.load.clustering != LoadOptions::Clustering::None && clustered && !clustered->fireRecords().empty()) {
+        // Post-load sort; result is the estimated compression ratio after it
+        const std::string impl = "impl=\"vector\"";
+        double sort_ms = 1000.0 * metrics.gauge("mini1_reorganize_seconds", "", impl).value();
+        double before = metrics.gauge("mini1_compression_ratio", "", impl + ",order=\"load\"").value();
+        double after = metrics.gauge("mini1_compression_ratio", "", impl + ",order=\"clustered\"").value();
+        std::cout << dataset << "," << cli.dsType << "," << mode_str(cli.threads)
+                  << ",load,reorganize,," << Clustering::name(cli.load.clustering) << "," << after << ",," << sort_ms << "\n";
+        std::cerr << "reorganize: estimated compression ratio " << before << " -> " << after << "\n";
+    }
 
     run_benchmarks(dataset, cli.dsType, cli.threads, *ds, col, cli.minVal, cli.maxVal, cli.year);
+
+    for (const auto& q : workload) {
+        if (q.minVal.empty()) continue;
+        auto t0 = clk::now();
+        RecordViews recs = ds->findByRange(q.col, q.minVal, q.maxVal);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        std::cout << dataset << "," << cli.dsType << "," << mode_str(cli.threads)
+                  << ",findByRange," << (int)q.col << ",[" << q.minVal << ";" << q.maxVal << "],"
+                  << recs.size() << "," << recs.size() << "," << ms << "\n";
+    }
+
+    if (!cli.within.empty()) {
+        auto* vec = dynamic_cast<VectorDataSource*>(base);
+        if (!vec) {
+            std::cerr << "Warning: --within needs the vector data source\n";
+        } else {
+            try {
+                for (const GeoShape& shape : GeoShapes::load(cli.within)) {
+                    auto t0 = clk::now();
+                    RecordViews inside = vec->findWithin(PolygonFilter(shape));
+                    double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+                    std::cout << dataset << "," << cli.dsType << "," << mode_str(cli.threads)
+                              << ",findWithin,Latitude/Longitude," << shape.name << ","
+                              << inside.size() << "," << inside.size() << "," << ms << "\n";
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Warning: " << e.what() << "\n";
+            }
+        }
+    }
+
+    if (!cli.metricsOut.empty() && !metrics.writeToFile(cli.metricsOut)) {
+        std::cerr << "Warning: could not write metrics to " << cli.metricsOut << "\n";
+    }
+    if (cli.metricsPort > 0 && cli.metricsLinger > 0) {
+        std::this_thread::sleep_for(std::chrono::seconds(cli.metricsLinger));
+    }
+    metrics.stop();
     return 0;
 }
@@ -0,0 +1,72 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Batched get-or-add over a load-time dictionary's values by id (the
+// names / sites vectors). A batch of keys is hashed first and each key's
+// home slot prefetched; the probes then run over lines already on their
+// way. The table is flat open addressing of (32-bit tag, id), verified
+// against values[id], and stands in for the dictionary's unordered_map,
+// which is left untouched: merge and finalize only need the values. New
+// keys get ids in batch order, as a row-at-a-time get-or-add would.
+template <typename Key, typename Hash = std::hash<Key>, typename Id = uint32_t>
+class BatchEncoder {
+public:
+    static constexpr size_t kBatch = 256;
+
+    BatchEncoder(std::vector<Key>& values) : values_(values) {
+        size_t capacity = 64;
+        while (capacity < 2 * values_.size()) capacity <<= 1;
+        rehash(capacity);
+    }
+
+    // ids[i] = id of *keys[i], adding unseen keys
+    void encode(const Key* const* keys, size_t n, Id* ids) {
+        uint64_t h[kBatch];
+        for (size_t b = 0; b < n; b += kBatch) {
+            const size_t m = std::min(kBatch, n - b);
+            for (size_t j = 0; j < m; ++j) {
+                h[j] = (uint64_t)hash_(*keys[b + j]);
+                __builtin_prefetch(&slots_[h[j] & mask_]);
+            }
+            for (size_t j = 0; j < m; ++j) ids[b + j] = probe_or_add(*keys[b + j], h[j]);
+        }
+    }
+
+private:
+    static constexpr uint64_t kEmpty = ~uint64_t(0);
+
+    Id probe_or_add(const Key& key, uint64_t h) {
+        const uint32_t tag = (uint32_t)(h >> 32);
+        size_t pos = h & mask_;
+        for (;; pos = (pos + 1) & mask_) {
+            const uint64_t slot = slots_[pos];
+            if (slot == kEmpty) break;
+            if ((uint32_t)(slot >> 32) == tag && values_[(uint32_t)slot] == key) return (Id)(uint32_t)slot;
+        }
+        const Id id = (Id)values_.size();
+        values_.push_back(key);
+        slots_[pos] = (uint64_t)tag << 32 | (uint32_t)id;
+        if (2 * values_.size() > slots_.size()) rehash(2 * slots_.size());
+        return id;
+    }
+
+    void rehash(size_t capacity) {
+        slots_.assign(capacity, kEmpty);
+        mask_ = capacity - 1;
+        for (uint32_t id = 0; id < (uint32_t)values_.size(); ++id) {
+            const uint64_t h = (uint64_t)hash_(values_[id]);
+            size_t pos = h & mask_;
+            while (slots_[pos] != kEmpty) pos = (pos + 1) & mask_;
+            slots_[pos] = (h >> 32) << 32 | id;
+        }
+    }
+
+    std::vector<Key>& values_;
+    Hash hash_;
+    std::vector<uint64_t> slots_;
+    size_t mask_ = 0;
+};
@@ -1,5 +1,7 @@
 #include "utility/CSVParser.h"
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 
 CSVParser::CSVParser(const std::string& path, bool hasHeader)
     : has_header_(hasHeader)
@@ -18,6 +20,7 @@ void CSVParser::skip_bom_if_any() {
     long pos = std::ftell(f_);
     size_t n = std::fread(bom, 1, 3, f_);
     if (n == 3 && bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF) {
+        pos_ = 3;
         return;
     }
     std::fseek(f_, pos, SEEK_SET);
@@ -47,20 +50,32 @@ bool CSVParser::next(std::vector<std::string>& out) {
 void CSVParser::reset() {
     if (!f_) return;
     std::fseek(f_, 0, SEEK_SET);
+    pos_ = 0;
+    end_ = UINT64_MAX;
     skip_bom_if_any();
     header_consumed_ = false;
     record_num_ = 0;
     line_buf_.clear();
-    store_.clear();
     fields_.clear();
 }
 
+void CSVParser::setRange(uint64_t begin, uint64_t end) {
+    if (begin > 0) {
+        std::fseek(f_, (long)begin, SEEK_SET);
+        pos_ = begin;
+        header_consumed_ = true;   // a mid-file range never starts at the header
+    }
+    end_ = end;
+}
+
 bool CSVParser::read_record(std::string& out) {
     out.clear();
+    if (pos_ >= end_) return false;
     bool in_quotes = false;
     for (;;) {
         int ch = std::fgetc(f_);
         if (ch == EOF) return !out.empty();
+        ++pos_;
         out.push_back(static_cast<char>(ch));
 
         if (ch == '"') {
@@ -75,45 +90,102 @@ bool CSVParser::read_record(std::string& out) {
 }
 
 void CSVParser::split_fields(const std::string& line) {
-    store_.clear();
-    fields_.clear();
+    splitLine(line, fields_, keep_);
+}
+
+void CSVParser::splitLine(const std::string& line, std::vector<std::string>& out, uint64_t keep) {
+    out.clear();
 
     const size_t n = line.size();
     size_t i = 0;
-
-    auto push = [&](std::string&& s){
-        store_.push_back(std::move(s));
-        fields_.push_back(store_.back());
-    };
+    bool lastEmpty = false;   // of the text, not of a skipped field's slot
 
     while (i <= n) {
-        if (i == n) { push(std::string{}); break; }
+        if (i == n) { out.emplace_back(); lastEmpty = true; break; }
+        const bool copy = (keep >> std::min<size_t>(out.size(), 63)) & 1;
 
         if (line[i] == '"') {
             std::string field;
+            size_t chars = 0;
             ++i;
             for (;;) {
                 if (i >= n) break;
                 char c = line[i++];
                 if (c == '"') {
-                    if (i < n && line[i] == '"') { field.push_back('"'); ++i; }
+                    if (i < n && line[i] == '"') { if (copy) field.push_back('"'); ++chars; ++i; }
                     else {
                         while (i < n && (line[i]==' ' || line[i]=='\t')) ++i;
                         if (i < n && line[i] == ',') ++i;
                         break;
                     }
-                } else field.push_back(c);
+                } else {
+                    if (copy) field.push_back(c);
+                    ++chars;
+                }
             }
-            push(std::move(field));
+            out.push_back(std::move(field));
+            lastEmpty = chars == 0;
         } else {
             size_t j = i; while (j < n && line[j] != ',') ++j;
             size_t end = j; while (end > i && (line[end-1]==' ' || line[end-1]=='\t')) --end;
-            push(std::string(line.data()+i, end-i));
+            if (copy) out.emplace_back(line.data()+i, end-i);
+            else out.emplace_back();
+            lastEmpty = end == i;
             i = (j < n ? j+1 : j);
         }
     }
 
-    if (!line.empty() && line.back() != ',' && !fields_.empty() && fields_.back().empty()) {
-        store_.pop_back(); fields_.pop_back();
+    if (!line.empty() && line.back() != ',' && !out.empty() && lastEmpty) {
+        out.pop_back();
+    }
+}
+
+size_t CSVParser::countLines(const std::string& path, uint64_t begin, uint64_t end, std::string* firstLine) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("CSVParser: failed to open: " + path);
+    if (begin > 0) std::fseek(f, (long)begin, SEEK_SET);
+    if (firstLine) firstLine->clear();
+
+    std::vector<char> buf(1 << 20);
+    uint64_t remaining = end - begin;
+    size_t lines = 0;
+    bool inFirst = firstLine != nullptr;
+    char last = '\n';
+    size_t n;
+    while (remaining > 0 && (n = std::fread(buf.data(), 1, (size_t)std::min<uint64_t>(buf.size(), remaining), f)) > 0) {
+        remaining -= n;
+        const char* p = buf.data();
+        const char* stop = p + n;
+        while (p < stop) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', stop - p));
+            if (inFirst) firstLine->append(p, nl ? nl : stop);
+            if (!nl) break;
+            inFirst = false;
+            ++lines;
+            p = nl + 1;
+        }
+        last = buf[n - 1];
+    }
+    std::fclose(f);
+    if (last != '\n') ++lines;
+    if (firstLine) {
+        while (!firstLine->empty() && firstLine->back() == '\r') firstLine->pop_back();
+        if (begin == 0 && firstLine->compare(0, 3, "\xEF\xBB\xBF") == 0) firstLine->erase(0, 3);
+    }
+    return lines;
+}
+
+uint64_t CSVParser::alignToLine(const std::string& path, uint64_t offset) {
+    if (offset == 0) return 0;
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("CSVParser: failed to open: " + path);
+    std::fseek(f, (long)(offset - 1), SEEK_SET);
+    uint64_t pos = offset - 1;
+    int ch;
+    while ((ch = std::fgetc(f)) != EOF) {
+        ++pos;
+        if (ch == '\n') break;
     }
+    std::fclose(f);
+    return pos;
 }
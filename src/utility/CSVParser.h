@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -25,6 +26,27 @@ public:
 
     size_t recordNumber() const { return record_num_; }
 
+    // Restrict reading to the byte range [begin, end) of the file. begin must
+    // be a line start (see alignToLine); records starting at or past end are
+    // not returned. Assumes no quoted newlines cross the boundaries.
+    void setRange(uint64_t begin, uint64_t end);
+
+    // Number of lines in [begin, end) (a trailing unterminated line counts).
+    // Cheap upper bound on records, used to pre-size load buffers. If
+    // firstLine is given it receives the first line of the range.
+    static size_t countLines(const std::string& path, uint64_t begin = 0,
+                             uint64_t end = UINT64_MAX, std::string* firstLine = nullptr);
+
+    // First line start at or after offset.
+    static uint64_t alignToLine(const std::string& path, uint64_t offset);
+
+    // Only fields whose bit is set in keep (field i -> bit i; fields past 63
+    // use bit 63) are copied out; the others are delimited but left empty.
+    void setFields(uint64_t keep) { keep_ = keep; }
+
+    // Split one already-read record into fields (see setFields for keep).
+    static void splitLine(const std::string& line, std::vector<std::string>& out, uint64_t keep = ~0ull);
+
 private:
     bool read_record(std::string& out);         // one logical record (may span lines)
     void split_fields(const std::string& line); // parse to fields_
@@ -35,8 +57,10 @@ private:
     const bool has_header_;
     bool header_consumed_{false};
     size_t record_num_{0};
+    uint64_t pos_{0};               // byte offset of the next unread char
+    uint64_t end_{UINT64_MAX};      // setRange() limit
+    uint64_t keep_{~0ull};          // setFields() mask
 
     std::string line_buf_;
-    std::vector<std::string> store_;
     std::vector<std::string> fields_;
 };
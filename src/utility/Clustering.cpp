@@ -0,0 +1,155 @@
+#include "utility/Clustering.h"
+#include "utility/ParallelSort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace Clustering {
+
+static unsigned bit_width(uint64_t v) {
+    unsigned bits = 0;
+    while (v) { ++bits; v >>= 1; }
+    return bits;
+}
+
+// Spread the low 21 bits of v to every third bit
+static uint64_t spread3(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffffull;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffull;
+    v = (v | (v << 8))  & 0x100f00f00f00f00full;
+    v = (v | (v << 4))  & 0x10c30c30c30c30c3ull;
+    v = (v | (v << 2))  & 0x1249249249249249ull;
+    return v;
+}
+
+// [lo, hi] -> [0, 2^21); NaN sorts last
+static uint64_t quantize21(double x, double lo, double hi) {
+    const double top = (double)((1u << 21) - 1);
+    if (std::isnan(x)) return (uint64_t)top;
+    if (hi <= lo) return 0;
+    return (uint64_t)std::min(top, std::max(0.0, (x - lo) / (hi - lo) * top));
+}
+
+std::vector<uint64_t> keys(const FireRecords& records, const SiteTable& sites, Key key) {
+    const size_t n = records.size();
+    std::vector<uint64_t> out(n, 0);
+    if (n == 0 || key == Key::None) return out;
+
+    int32_t utcMin = records[0].utc_minutes, utcMax = utcMin;
+    uint32_t paramMax = 0, siteMax = 0;
+    for (const auto& r : records) {
+        utcMin = std::min(utcMin, r.utc_minutes);
+        utcMax = std::max(utcMax, r.utc_minutes);
+        paramMax = std::max<uint32_t>(paramMax, r.parameter_id);
+        siteMax = std::max(siteMax, r.site_id);
+    }
+
+    if (key == Key::ParameterSiteTime) {
+        const unsigned siteBits = bit_width(siteMax);
+        // At most 63, so the shifts below stay defined with one site and parameter
+        const unsigned timeBits = std::min(63u, 64 - bit_width(paramMax) - siteBits);
+        const unsigned need = bit_width((uint64_t)((int64_t)utcMax - utcMin));
+        const unsigned shift = need > timeBits ? need - timeBits : 0;
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < (long long)n; ++i) {
+            const FireRecord& r = records[i];
+            const uint64_t t = (uint64_t)((int64_t)r.utc_minutes - utcMin) >> shift;
+            out[i] = ((uint64_t)r.parameter_id << (siteBits + timeBits)) | ((uint64_t)r.site_id << timeBits) | t;
+        }
+        return out;
+    }
+
+    double latMin = 90.0, latMax = -90.0, lonMin = 180.0, lonMax = -180.0;
+    for (const auto& s : sites) {
+        if (std::isnan(s.latitude) || std::isnan(s.longitude)) continue;
+        latMin = std::min(latMin, (double)s.latitude);
+        latMax = std::max(latMax, (double)s.latitude);
+        lonMin = std::min(lonMin, (double)s.longitude);
+        lonMax = std::max(lonMax, (double)s.longitude);
+    }
+    const double hourMin = std::floor(utcMin / 60.0), hourMax = std::floor(utcMax / 60.0);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)n; ++i) {
+        const FireRecord& r = records[i];
+        const SiteRecord& s = sites[r.site_id];
+        out[i] = (spread3(quantize21(std::floor(r.utc_minutes / 60.0), hourMin, hourMax)) << 2)
+               | (spread3(quantize21(s.latitude, latMin, latMax)) << 1)
+               |  spread3(quantize21(s.longitude, lonMin, lonMax));
+    }
+    return out;
+}
+
+std::vector<uint32_t> order(const FireRecords& records, const SiteTable& sites, Key key) {
+    const std::vector<uint64_t> k = keys(records, sites, key);
+    std::vector<std::pair<uint64_t, uint32_t>> pairs(k.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)k.size(); ++i) pairs[i] = {k[i], (uint32_t)i};
+    parallel_radix_sort(pairs);
+
+    std::vector<uint32_t> out(pairs.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)pairs.size(); ++i) out[i] = pairs[i].second;
+    return out;
+}
+
+void permute(FireRecords& records, const std::vector<uint32_t>& order) {
+    FireRecords sorted(records.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)order.size(); ++i) sorted[i] = records[order[i]];
+    records.swap(sorted);
+}
+
+// Bits for one block of one column: frame of reference (offsets from the
+// block minimum at a fixed width) or runs of (offset, 12-bit length).
+template <typename Get>
+static double block_bits(const FireRecord* rows, size_t count, Get get) {
+    uint64_t lo = get(rows[0]), hi = lo;
+    size_t runs = 1;
+    for (size_t i = 1; i < count; ++i) {
+        const uint64_t v = get(rows[i]);
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        if (v != get(rows[i - 1])) ++runs;
+    }
+    const double width = bit_width(hi - lo);
+    const double header = 64.0;
+    return header + std::min(width * count, runs * (width + 12.0));
+}
+
+double compressionRatio(const FireRecords& records, size_t blockRows) {
+    const size_t n = records.size();
+    if (n == 0 || blockRows == 0) return 1.0;
+    auto bits_of = [](float f) { uint32_t u; std::memcpy(&u, &f, sizeof u); return (uint64_t)u; };
+    const double rawBits = 8.0 * n * (sizeof(int32_t) + 2 * sizeof(uint16_t) + 2 * sizeof(float)
+                                      + sizeof(int16_t) + sizeof(uint8_t) + sizeof(uint32_t));
+
+    const long long blocks = (long long)((n + blockRows - 1) / blockRows);
+    double packedBits = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:packedBits)
+    for (long long b = 0; b < blocks; ++b) {
+        const FireRecord* rows = records.data() + b * blockRows;
+        const size_t count = std::min(blockRows, n - (size_t)b * blockRows);
+        packedBits += block_bits(rows, count, [](const FireRecord& r) { return (uint64_t)(uint32_t)r.utc_minutes; })
+                    + block_bits(rows, count, [](const FireRecord& r) { return (uint64_t)r.parameter_id; })
+                    + block_bits(rows, count, [](const FireRecord& r) { return (uint64_t)r.unit_id; })
+                    + block_bits(rows, count, [&](const FireRecord& r) { return bits_of(r.value); })
+                    + block_bits(rows, count, [&](const FireRecord& r) { return bits_of(r.raw_value); })
+                    + block_bits(rows, count, [](const FireRecord& r) { return (uint64_t)(uint16_t)r.aqi; })
+                    + block_bits(rows, count, [](const FireRecord& r) { return (uint64_t)r.category; })
+                    + block_bits(rows, count, [](const FireRecord& r) { return (uint64_t)r.site_id; });
+    }
+    return rawBits / packedBits;
+}
+
+const char* name(Key key) {
+    switch (key) {
+        case Key::ParameterSiteTime: return "parameter-site-time";
+        case Key::ZOrder: return "zorder";
+        default: return "none";
+    }
+}
+
+} // namespace Clustering
@@ -0,0 +1,30 @@
+#pragma once
+#include "../interfaces/LoadOptions.h"
+#include "Records.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Physical reorganization of fire rows by a clustering key.
+namespace Clustering {
+    using Key = LoadOptions::Clustering;
+
+    // One 64-bit sort key per row. ParameterSiteTime packs parameter_id,
+    // site_id and the minute offset, each in just the bits the data needs
+    // (time is coarsened if they do not fit). ZOrder interleaves 21 bits
+    // each of latitude, longitude and hour, scaled to the data's extent.
+    std::vector<uint64_t> keys(const FireRecords& records, const SiteTable& sites, Key key);
+
+    // Row permutation: new row i is old row order[i]. Ties keep load order.
+    std::vector<uint32_t> order(const FireRecords& records, const SiteTable& sites, Key key);
+
+    // Apply a permutation from order() in parallel.
+    void permute(FireRecords& records, const std::vector<uint32_t>& order);
+
+    // Estimated raw/compressed size of the fire columns when every block of
+    // blockRows rows is frame-of-reference or run-length encoded per column,
+    // whichever is smaller. A proxy for how well an order clusters values.
+    double compressionRatio(const FireRecords& records, size_t blockRows);
+
+    const char* name(Key key);
+}
@@ -0,0 +1,106 @@
+#include "utility/FrozenDictionary.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+uint64_t FrozenDictionary::hash(std::string_view key) {
+    // FNV-1a, then a splitmix64 finalizer so both halves are well mixed
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : key) { h ^= c; h *= 0x100000001b3ull; }
+    h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27; h *= 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+uint32_t FrozenDictionary::slot_of(uint64_t h, uint32_t displacement, uint32_t n) {
+    uint64_t x = h + (uint64_t)displacement * 0x9E3779B97F4A7C15ull;
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdull; x ^= x >> 33;
+    return (uint32_t)(((x & 0xffffffffull) * n) >> 32);
+}
+
+FrozenDictionary::FrozenDictionary(const std::vector<std::string>& names) {
+    const uint32_t n = (uint32_t)names.size();
+    size_t bytes = 0;
+    for (const auto& s : names) bytes += s.size();
+    arena_.reserve(bytes);
+    offsets_.reserve(n + 1);
+    offsets_.push_back(0);
+    for (const auto& s : names) {
+        arena_ += s;
+        offsets_.push_back((uint32_t)arena_.size());
+    }
+    if (n == 0) return;
+
+    // Keys by bucket (high hash bits); placed largest bucket first, each
+    // trying displacements until all its keys land on free, distinct slots
+    const uint32_t buckets = (n + kKeysPerBucket - 1) / kKeysPerBucket;
+    std::vector<uint64_t> h(n);
+    std::vector<std::vector<uint32_t>> members(buckets);
+    for (uint32_t id = 0; id < n; ++id) {
+        h[id] = hash(names[id]);
+        members[(uint32_t)(((h[id] >> 32) * buckets) >> 32)].push_back(id);
+    }
+    std::vector<uint32_t> order(buckets);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) { return members[a].size() > members[b].size(); });
+
+    displacement_.assign(buckets, 0);
+    slot_id_.assign(n, kNotFound);
+    std::vector<uint32_t> slots;
+    for (uint32_t b : order) {
+        if (members[b].empty()) break;
+        for (uint32_t d = 0;; ++d) {
+            if (d == (1u << 24)) throw std::runtime_error("FrozenDictionary: no displacement found (duplicate names?)");
+            slots.clear();
+            bool ok = true;
+            for (uint32_t id : members[b]) {
+                const uint32_t s = slot_of(h[id], d, n);
+                if (slot_id_[s] != kNotFound || std::find(slots.begin(), slots.end(), s) != slots.end()) { ok = false; break; }
+                slots.push_back(s);
+            }
+            if (!ok) continue;
+            displacement_[b] = d;
+            for (size_t i = 0; i < slots.size(); ++i) slot_id_[slots[i]] = members[b][i];
+            break;
+        }
+    }
+}
+
+uint32_t FrozenDictionary::find(std::string_view key) const {
+    const uint32_t n = (uint32_t)slot_id_.size();
+    if (n == 0) return kNotFound;
+    const uint64_t h = hash(key);
+    const uint32_t b = (uint32_t)(((h >> 32) * displacement_.size()) >> 32);
+    const uint32_t id = slot_id_[slot_of(h, displacement_[b], n)];
+    return name(id) == key ? id : kNotFound;
+}
+
+size_t FrozenDictionary::lower_bound(std::string_view key) const {
+    size_t lo = 0, hi = size();
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (name((uint32_t)mid) < key) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+size_t FrozenDictionary::upper_bound(std::string_view key) const {
+    size_t lo = 0, hi = size();
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (!(key < name((uint32_t)mid))) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+std::pair<uint32_t, uint32_t> FrozenDictionary::idRange(std::string_view lo, std::string_view hi) const {
+    if (hi < lo) return {0, 0};
+    const uint32_t first = (uint32_t)lower_bound(lo);
+    return {first, std::max(first, (uint32_t)upper_bound(hi))};
+}
+
+size_t FrozenDictionary::memoryBytes() const {
+    return arena_.capacity() + (offsets_.capacity() + displacement_.capacity() + slot_id_.capacity()) * sizeof(uint32_t);
+}
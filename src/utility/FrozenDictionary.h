@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Read-only string <-> id dictionary for after load. Names live back to back
+// in one arena (id -> name is an offset lookup). Name -> id goes through a
+// minimal perfect hash (hash-and-displace, CHD style): a key's bucket holds
+// a displacement that sends every key of the bucket to its own slot of
+// [0, n), and the slot holds the id. Lookups verify against the arena, so
+// unknown names are rejected.
+class FrozenDictionary {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    FrozenDictionary() = default;
+    // Ids are positions in names; names must be distinct.
+    explicit FrozenDictionary(const std::vector<std::string>& names);
+
+    uint32_t find(std::string_view name) const;
+    std::string_view name(uint32_t id) const {
+        return std::string_view(arena_.data() + offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+
+    // Ids [first, last) of names in [lo, hi] (inclusive); names must have
+    // been given in sorted order.
+    std::pair<uint32_t, uint32_t> idRange(std::string_view lo, std::string_view hi) const;
+
+    size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    size_t memoryBytes() const;
+
+private:
+    static constexpr uint32_t kKeysPerBucket = 4;
+
+    static uint64_t hash(std::string_view key);
+    static uint32_t slot_of(uint64_t h, uint32_t displacement, uint32_t n);
+    size_t lower_bound(std::string_view key) const;
+    size_t upper_bound(std::string_view key) const;
+
+    std::string arena_;
+    std::vector<uint32_t> offsets_;        // size() + 1
+    std::vector<uint32_t> displacement_;   // per bucket
+    std::vector<uint32_t> slot_id_;        // slot -> id
+};
@@ -0,0 +1,297 @@
+#include "utility/GeoShapes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// -------- tiny JSON DOM (enough for GeoJSON) --------
+struct Json {
+    enum class Type { Null, Bool, Number, String, Array, Object } type = Type::Null;
+    double number = 0.0;
+    std::string str;
+    std::vector<Json> items;
+    std::map<std::string, Json> fields;
+
+    const Json* get(const std::string& key) const {
+        auto it = fields.find(key);
+        return it == fields.end() ? nullptr : &it->second;
+    }
+};
+
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : s_(text) {}
+
+    Json parse() {
+        Json v = value();
+        skip_ws();
+        if (i_ != s_.size()) fail("trailing characters");
+        return v;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("GeoJSON: " + what + " at offset " + std::to_string(i_));
+    }
+
+    void skip_ws() { while (i_ < s_.size() && std::isspace((unsigned char)s_[i_])) ++i_; }
+
+    void expect(char c) {
+        skip_ws();
+        if (i_ >= s_.size() || s_[i_] != c) fail(std::string("expected '") + c + "'");
+        ++i_;
+    }
+
+    Json value() {
+        skip_ws();
+        if (i_ >= s_.size()) fail("unexpected end");
+        Json v;
+        const char c = s_[i_];
+        if (c == '{') {
+            v.type = Json::Type::Object;
+            ++i_;
+            skip_ws();
+            if (i_ < s_.size() && s_[i_] == '}') { ++i_; return v; }
+            for (;;) {
+                skip_ws();
+                std::string key = string();
+                expect(':');
+                v.fields[key] = value();
+                skip_ws();
+                if (i_ < s_.size() && s_[i_] == ',') { ++i_; continue; }
+                expect('}');
+                return v;
+            }
+        }
+        if (c == '[') {
+            v.type = Json::Type::Array;
+            ++i_;
+            skip_ws();
+            if (i_ < s_.size() && s_[i_] == ']') { ++i_; return v; }
+            for (;;) {
+                v.items.push_back(value());
+                skip_ws();
+                if (i_ < s_.size() && s_[i_] == ',') { ++i_; continue; }
+                expect(']');
+                return v;
+            }
+        }
+        if (c == '"') { v.type = Json::Type::String; v.str = string(); return v; }
+        if (s_.compare(i_, 4, "true") == 0)  { i_ += 4; v.type = Json::Type::Bool; v.number = 1; return v; }
+        if (s_.compare(i_, 5, "false") == 0) { i_ += 5; v.type = Json::Type::Bool; return v; }
+        if (s_.compare(i_, 4, "null") == 0)  { i_ += 4; return v; }
+
+        const char* begin = s_.c_str() + i_;
+        char* end = nullptr;
+        v.number = std::strtod(begin, &end);
+        if (end == begin) fail("bad value");
+        v.type = Json::Type::Number;
+        i_ += (size_t)(end - begin);
+        return v;
+    }
+
+    std::string string() {
+        if (i_ >= s_.size() || s_[i_] != '"') fail("expected string");
+        ++i_;
+        std::string out;
+        while (i_ < s_.size() && s_[i_] != '"') {
+            char c = s_[i_++];
+            if (c == '\\' && i_ < s_.size()) {
+                char e = s_[i_++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': out += '?'; i_ = std::min(s_.size(), i_ + 4); break;   // names only; no need to decode
+                    default:  out += e; break;
+                }
+            } else {
+                out += c;
+            }
+        }
+        if (i_ >= s_.size()) fail("unterminated string");
+        ++i_;
+        return out;
+    }
+
+    const std::string& s_;
+    size_t i_ = 0;
+};
+
+GeoShape::Ring json_ring(const Json& ring) {
+    GeoShape::Ring out;
+    for (const Json& p : ring.items) {
+        if (p.items.size() < 2) throw std::runtime_error("GeoJSON: position needs [lon, lat]");
+        out.push_back(GeoShape::Point{p.items[0].number, p.items[1].number});
+    }
+    // Rings repeat the first vertex at the end; edges close implicitly here
+    if (out.size() > 1 && out.front().lon == out.back().lon && out.front().lat == out.back().lat) out.pop_back();
+    return out;
+}
+
+void json_geometry(const Json& geom, GeoShape& shape) {
+    const Json* type = geom.get("type");
+    const Json* coords = geom.get("coordinates");
+    if (!type || !coords) return;
+    if (type->str == "Polygon") {
+        for (const Json& ring : coords->items) shape.rings.push_back(json_ring(ring));
+    } else if (type->str == "MultiPolygon") {
+        for (const Json& poly : coords->items)
+            for (const Json& ring : poly.items) shape.rings.push_back(json_ring(ring));
+    }
+}
+
+std::string feature_name(const Json& feature) {
+    if (const Json* props = feature.get("properties")) {
+        for (const char* key : {"name", "NAME", "Name"}) {
+            if (const Json* n = props->get(key)) if (n->type == Json::Type::String) return n->str;
+        }
+    }
+    return "";
+}
+
+// -------- WKT --------
+class WktReader {
+public:
+    explicit WktReader(const std::string& text) : s_(text) {}
+
+    // One geometry starting at the current position; false at end of input.
+    bool next(GeoShape& shape) {
+        skip_ws();
+        if (i_ >= s_.size()) return false;
+        std::string tag = word();
+        if (s_.compare(i_, 5, "EMPTY") == 0) { i_ += 5; return true; }
+        if (tag == "POLYGON") {
+            polygon(shape);
+        } else if (tag == "MULTIPOLYGON") {
+            expect('(');
+            for (;;) {
+                polygon(shape);
+                skip_ws();
+                if (peek() == ',') { ++i_; continue; }
+                expect(')');
+                break;
+            }
+        } else {
+            throw std::runtime_error("WKT: unsupported geometry '" + tag + "'");
+        }
+        return true;
+    }
+
+private:
+    void skip_ws() { while (i_ < s_.size() && (std::isspace((unsigned char)s_[i_]) || s_[i_] == ';')) ++i_; }
+    char peek() const { return i_ < s_.size() ? s_[i_] : '\0'; }
+
+    void expect(char c) {
+        skip_ws();
+        if (peek() != c) throw std::runtime_error(std::string("WKT: expected '") + c + "' at offset " + std::to_string(i_));
+        ++i_;
+    }
+
+    std::string word() {
+        std::string w;
+        while (i_ < s_.size() && std::isalpha((unsigned char)s_[i_])) w += (char)std::toupper((unsigned char)s_[i_++]);
+        skip_ws();
+        return w;   // Z/M variants are not supported
+    }
+
+    double number() {
+        skip_ws();
+        const char* begin = s_.c_str() + i_;
+        char* end = nullptr;
+        double v = std::strtod(begin, &end);
+        if (end == begin) throw std::runtime_error("WKT: expected number at offset " + std::to_string(i_));
+        i_ += (size_t)(end - begin);
+        return v;
+    }
+
+    void polygon(GeoShape& shape) {
+        expect('(');
+        for (;;) {
+            expect('(');
+            GeoShape::Ring ring;
+            for (;;) {
+                double lon = number();
+                double lat = number();
+                ring.push_back(GeoShape::Point{lon, lat});
+                skip_ws();
+                if (peek() == ',') { ++i_; continue; }
+                expect(')');
+                break;
+            }
+            if (ring.size() > 1 && ring.front().lon == ring.back().lon && ring.front().lat == ring.back().lat) ring.pop_back();
+            shape.rings.push_back(std::move(ring));
+            skip_ws();
+            if (peek() == ',') { ++i_; continue; }
+            expect(')');
+            break;
+        }
+    }
+
+    const std::string& s_;
+    size_t i_ = 0;
+};
+
+} // namespace
+
+namespace GeoShapes {
+
+std::vector<GeoShape> parseGeoJson(const std::string& text) {
+    Json root = JsonReader(text).parse();
+    std::vector<GeoShape> out;
+    auto add_feature = [&](const Json& feature) {
+        GeoShape shape;
+        shape.name = feature_name(feature);
+        if (const Json* geom = feature.get("geometry")) json_geometry(*geom, shape);
+        if (!shape.rings.empty()) out.push_back(std::move(shape));
+    };
+
+    const Json* type = root.get("type");
+    if (!type) throw std::runtime_error("GeoJSON: missing \"type\"");
+    if (type->str == "FeatureCollection") {
+        if (const Json* features = root.get("features")) for (const Json& f : features->items) add_feature(f);
+    } else if (type->str == "Feature") {
+        add_feature(root);
+    } else {
+        GeoShape shape;
+        json_geometry(root, shape);
+        if (!shape.rings.empty()) out.push_back(std::move(shape));
+    }
+    return out;
+}
+
+std::vector<GeoShape> parseWkt(const std::string& text) {
+    std::vector<GeoShape> out;
+    WktReader reader(text);
+    for (;;) {
+        GeoShape shape;
+        if (!reader.next(shape)) break;
+        if (!shape.rings.empty()) out.push_back(std::move(shape));
+    }
+    return out;
+}
+
+std::vector<GeoShape> load(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw std::runtime_error("GeoShapes: failed to open: " + path);
+    std::ostringstream buf;
+    buf << f.rdbuf();
+    const std::string text = buf.str();
+
+    size_t first = text.find_first_not_of(" \t\r\n");
+    std::vector<GeoShape> shapes = (first != std::string::npos && text[first] == '{') ? parseGeoJson(text) : parseWkt(text);
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (shapes[i].name.empty()) shapes[i].name = path + "#" + std::to_string(i);
+    }
+    return shapes;
+}
+
+} // namespace GeoShapes
@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// A (multi)polygon in degrees. All rings of all parts are kept flat and
+// combined with the even-odd rule, which covers holes and disjoint parts.
+struct GeoShape {
+    struct Point { double lon = 0.0, lat = 0.0; };
+    using Ring = std::vector<Point>;
+
+    std::string name;           // feature "name"/"NAME" property; load() falls back to path#index
+    std::vector<Ring> rings;    // closed implicitly (last -> first)
+};
+
+// Minimal readers for local boundary files: GeoJSON (Feature,
+// FeatureCollection or bare Polygon/MultiPolygon geometry; other geometry
+// types are skipped) and WKT (POLYGON / MULTIPOLYGON, separated by any
+// whitespace or ';', so one per line works; other tags are an error).
+namespace GeoShapes {
+    // Detects the format from the first non-blank character ('{' = GeoJSON).
+    // Throws std::runtime_error on unreadable or malformed input.
+    std::vector<GeoShape> load(const std::string& path);
+
+    std::vector<GeoShape> parseGeoJson(const std::string& text);
+    std::vector<GeoShape> parseWkt(const std::string& text);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+// Most lookups interleave_lookups keeps in flight
+constexpr size_t kMaxInterleave = 32;
+
+// Asynchronous memory access chaining (AMAC): runs lookups 0..n-1 with up
+// to `group` of them in flight. start(i, state) begins lookup i and
+// prefetches the first line it needs; step(state) makes one dependent
+// access (already prefetched), prefetches the next one and returns true
+// once the lookup has stored its result. Stepping the in-flight lookups
+// round-robin overlaps their cache misses; a finished slot takes the next
+// lookup. group == 1 degenerates to sequential lookups.
+template <typename State, typename Start, typename Step>
+void interleave_lookups(size_t n, size_t group, Start&& start, Step&& step) {
+    if (n == 0) return;
+    group = std::max<size_t>(1, std::min({group, kMaxInterleave, n}));
+    State ring[kMaxInterleave];
+    bool live[kMaxInterleave];
+    size_t next = 0;
+    for (; next < group; ++next) {
+        start(next, ring[next]);
+        live[next] = true;
+    }
+    for (size_t k = 0, active = group; active; k = k + 1 == group ? 0 : k + 1) {
+        if (!live[k] || !step(ring[k])) continue;
+        if (next < n) {
+            start(next++, ring[k]);
+        } else {
+            live[k] = false;
+            --active;
+        }
+    }
+}
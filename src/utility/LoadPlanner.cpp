@@ -0,0 +1,88 @@
+#include "utility/LoadPlanner.h"
+#include "utility/CSVParser.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+
+namespace fs = std::filesystem;
+
+namespace LoadPlanner {
+
+std::vector<LoadTask> discover(const std::string& root, const std::string& ext) {
+    std::vector<LoadTask> files;
+    std::vector<std::string> frontier{root};
+
+    // Breadth-first: list every directory of the current level in parallel
+    while (!frontier.empty()) {
+        const long long n = (long long)frontier.size();
+        std::vector<std::vector<LoadTask>> levelFiles(frontier.size());
+        std::vector<std::vector<std::string>> levelDirs(frontier.size());
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long i = 0; i < n; ++i) {
+            std::error_code ec;
+            for (auto const& entry : fs::directory_iterator(frontier[i], ec)) {
+                std::error_code sec;
+                if (entry.is_directory(sec)) {
+                    levelDirs[i].push_back(entry.path().string());
+                } else if (entry.is_regular_file(sec) && entry.path().extension() == ext) {
+                    LoadTask t;
+                    t.path = entry.path().string();
+                    t.end = (uint64_t)entry.file_size(sec);
+                    levelFiles[i].push_back(std::move(t));
+                }
+            }
+        }
+
+        frontier.clear();
+        for (size_t i = 0; i < levelFiles.size(); ++i) {
+            for (auto& t : levelFiles[i]) files.push_back(std::move(t));
+            for (auto& d : levelDirs[i]) frontier.push_back(std::move(d));
+        }
+    }
+
+    std::sort(files.begin(), files.end(),
+        [](const LoadTask& a, const LoadTask& b) { return a.path < b.path; });
+    return files;
+}
+
+std::vector<LoadTask> splitOversized(const std::vector<LoadTask>& tasks, uint64_t chunkBytes) {
+    if (chunkBytes == 0) return tasks;
+    std::vector<LoadTask> out;
+    out.reserve(tasks.size());
+    for (const auto& t : tasks) {
+        if (t.bytes() <= chunkBytes) { out.push_back(t); continue; }
+        uint64_t begin = t.begin;
+        while (begin < t.end) {
+            uint64_t end = begin + chunkBytes >= t.end
+                         ? t.end
+                         : std::min(t.end, CSVParser::alignToLine(t.path, begin + chunkBytes));
+            LoadTask c;
+            c.path = t.path;
+            c.begin = begin;
+            c.end = end;
+            c.firstChunk = begin == t.begin && t.firstChunk;
+            out.push_back(std::move(c));
+            begin = end;
+        }
+    }
+    return out;
+}
+
+std::vector<size_t> largestFirst(const std::vector<LoadTask>& tasks) {
+    std::vector<size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&](size_t a, size_t b) { return tasks[a].bytes() > tasks[b].bytes(); });
+    return order;
+}
+
+double tailSeconds(std::vector<double> threadFinish) {
+    if (threadFinish.size() < 2) return 0.0;
+    std::sort(threadFinish.begin(), threadFinish.end());
+    double median = threadFinish[threadFinish.size() / 2];
+    return threadFinish.back() - median;
+}
+
+} // namespace LoadPlanner
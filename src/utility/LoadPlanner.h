@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A unit of load work: a whole file or a line-aligned byte range of one.
+struct LoadTask {
+    std::string path;
+    uint64_t begin = 0;     // [begin, end) in bytes
+    uint64_t end = 0;
+    bool firstChunk = true; // begin of its file (counts the file once)
+
+    uint64_t bytes() const { return end - begin; }
+};
+
+namespace LoadPlanner {
+    // Recursively list files with the given extension, enumerating each
+    // directory level in parallel. Sorted by path (directory order).
+    std::vector<LoadTask> discover(const std::string& root, const std::string& ext = ".csv");
+
+    // Split tasks larger than chunkBytes into line-aligned chunks (0 = off).
+    // Chunks of a file stay adjacent and in byte order.
+    std::vector<LoadTask> splitOversized(const std::vector<LoadTask>& tasks, uint64_t chunkBytes);
+
+    // Task indices sorted largest-first (LPT schedule); ties keep input order.
+    std::vector<size_t> largestFirst(const std::vector<LoadTask>& tasks);
+
+    // Load imbalance: last thread finish minus median thread finish.
+    double tailSeconds(std::vector<double> threadFinish);
+}
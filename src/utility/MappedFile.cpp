@@ -0,0 +1,46 @@
+#include "utility/MappedFile.h"
+
+#include <cstdio>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* p = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            data_ = static_cast<const char*>(p);
+            size_ = (size_t)st.st_size;
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+    if (mapped_) return;
+#endif
+    // No mmap: read the file once
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return;
+    std::fseek(f, 0, SEEK_END);
+    const long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    if (size > 0) {
+        buffer_.reset(new char[(size_t)size]);
+        size_ = std::fread(buffer_.get(), 1, (size_t)size, f);
+        data_ = buffer_.get();
+    }
+    std::fclose(f);
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Read-only bytes of a whole file: mmapped where the platform has it, read
+// into memory otherwise. Empty when the file is missing or empty.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::unique_ptr<char[]> buffer_;   // fallback copy
+};
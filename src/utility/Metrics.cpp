@@ -0,0 +1,247 @@
+#include "utility/Metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// -------- Gauge --------
+static inline uint64_t to_bits(double v) { uint64_t b; std::memcpy(&b, &v, sizeof b); return b; }
+static inline double from_bits(uint64_t b) { double v; std::memcpy(&v, &b, sizeof v); return v; }
+
+void Gauge::set(double v) { bits_.store(to_bits(v), std::memory_order_relaxed); }
+
+void Gauge::add(double v) {
+    uint64_t cur = bits_.load(std::memory_order_relaxed);
+    while (!bits_.compare_exchange_weak(cur, to_bits(from_bits(cur) + v), std::memory_order_relaxed)) {}
+}
+
+double Gauge::value() const { return from_bits(bits_.load(std::memory_order_relaxed)); }
+
+// -------- IngestLag --------
+IngestLag::IngestLag(const std::string& labels)
+    : gauge_(MetricsRegistry::instance().gauge(
+          "mini1_ingest_lag_seconds", "Wall clock minus newest ingested observation", labels)) {}
+
+void IngestLag::observe(int32_t newestUtcMinutes) {
+    int32_t seen = newest_.load(std::memory_order_relaxed);
+    while (newestUtcMinutes > seen &&
+           !newest_.compare_exchange_weak(seen, newestUtcMinutes, std::memory_order_relaxed)) {}
+    long long nowSec = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    gauge_.set((double)(nowSec - (long long)std::max(seen, newestUtcMinutes) * 60));
+}
+
+// -------- Histogram --------
+Histogram::Histogram(std::vector<double> upperBounds) : bounds_(std::move(upperBounds)) {
+    std::sort(bounds_.begin(), bounds_.end());
+    buckets_.reset(new std::atomic<uint64_t>[bounds_.size() + 1]);
+    for (size_t i = 0; i <= bounds_.size(); ++i) buckets_[i].store(0, std::memory_order_relaxed);
+}
+
+void Histogram::observe(double v) {
+    // Non-cumulative buckets internally; export accumulates.
+    size_t i = std::lower_bound(bounds_.begin(), bounds_.end(), v) - bounds_.begin();
+    buckets_[i].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.add(v);
+}
+
+// -------- Registry --------
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::~MetricsRegistry() { stop(); }
+
+std::vector<double> MetricsRegistry::defaultLatencyBuckets() {
+    return {1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3, 1e-2, 5e-2, 0.1, 0.5, 1.0, 5.0, 10.0};
+}
+
+MetricsRegistry::Entry* MetricsRegistry::find(Kind kind, const std::string& name, const std::string& labels) {
+    for (auto& e : entries_) {
+        if (e.kind == kind && e.name == name && e.labels == labels) return &e;
+    }
+    return nullptr;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (Entry* e = find(Kind::Counter, name, labels)) return *e->counter;
+    counters_.emplace_back();
+    Entry e{Kind::Counter, name, help, labels};
+    e.counter = &counters_.back();
+    entries_.push_back(e);
+    return counters_.back();
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (Entry* e = find(Kind::Gauge, name, labels)) return *e->gauge;
+    gauges_.emplace_back();
+    Entry e{Kind::Gauge, name, help, labels};
+    e.gauge = &gauges_.back();
+    entries_.push_back(e);
+    return gauges_.back();
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::string& labels, std::vector<double> upperBounds) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (Entry* e = find(Kind::Histogram, name, labels)) return *e->histogram;
+    histograms_.emplace_back(std::move(upperBounds));
+    Entry e{Kind::Histogram, name, help, labels};
+    e.histogram = &histograms_.back();
+    entries_.push_back(e);
+    return histograms_.back();
+}
+
+static std::string fmt_double(double v) {
+    if (std::isinf(v)) return v > 0 ? "+Inf" : "-Inf";
+    if (std::isnan(v)) return "NaN";
+    std::ostringstream os;
+    os.precision(15);
+    os << v;
+    return os.str();
+}
+
+static std::string with_labels(const std::string& labels, const std::string& extra = "") {
+    if (labels.empty() && extra.empty()) return "";
+    if (labels.empty()) return "{" + extra + "}";
+    if (extra.empty()) return "{" + labels + "}";
+    return "{" + labels + "," + extra + "}";
+}
+
+std::string MetricsRegistry::exportText() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    std::ostringstream out;
+
+    // Group series by family so HELP/TYPE appear once per name.
+    std::vector<const Entry*> sorted;
+    sorted.reserve(entries_.size());
+    for (const auto& e : entries_) sorted.push_back(&e);
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+    const std::string* lastFamily = nullptr;
+    for (const Entry* e : sorted) {
+        if (!lastFamily || *lastFamily != e->name) {
+            const char* type = e->kind == Kind::Counter ? "counter"
+                             : e->kind == Kind::Gauge   ? "gauge" : "histogram";
+            out << "# HELP " << e->name << " " << e->help << "\n";
+            out << "# TYPE " << e->name << " " << type << "\n";
+            lastFamily = &e->name;
+        }
+        switch (e->kind) {
+            case Kind::Counter:
+                out << e->name << with_labels(e->labels) << " " << e->counter->value() << "\n";
+                break;
+            case Kind::Gauge:
+                out << e->name << with_labels(e->labels) << " " << fmt_double(e->gauge->value()) << "\n";
+                break;
+            case Kind::Histogram: {
+                const Histogram& h = *e->histogram;
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < h.bounds().size(); ++i) {
+                    cumulative += h.bucketCount(i);
+                    out << e->name << "_bucket" << with_labels(e->labels, "le=\"" + fmt_double(h.bounds()[i]) + "\"")
+                        << " " << cumulative << "\n";
+                }
+                cumulative += h.bucketCount(h.bounds().size());
+                out << e->name << "_bucket" << with_labels(e->labels, "le=\"+Inf\"") << " " << cumulative << "\n";
+                out << e->name << "_sum" << with_labels(e->labels) << " " << fmt_double(h.sum()) << "\n";
+                out << e->name << "_count" << with_labels(e->labels) << " " << h.count() << "\n";
+                break;
+            }
+        }
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::writeToFile(const std::string& path) const {
+    // Write-then-rename so a scraper never reads a half-written file.
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f) return false;
+        f << exportText();
+        if (!f) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+// -------- HTTP endpoint --------
+#ifndef _WIN32
+bool MetricsRegistry::serve(int port) {
+    if (serving_.load()) return false;
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, (sockaddr*)&addr, sizeof addr) < 0 || ::listen(fd, 8) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    listen_fd_ = fd;
+    serving_.store(true);
+    server_ = std::thread([this, fd]() {
+        while (serving_.load()) {
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client < 0) continue;
+            // One client at a time: an idle or stalled one must not block later scrapes
+            timeval timeout{};
+            timeout.tv_sec = 2;
+            ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+            ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof timeout);
+
+            char req[1024];
+            (void)::recv(client, req, sizeof req, 0);   // any path returns the metrics page
+
+            const std::string body = exportText();
+            const std::string resp =
+                "HTTP/1.0 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                "Connection: close\r\n\r\n" + body;
+            size_t sent = 0;
+            while (sent < resp.size()) {
+                ssize_t n = ::send(client, resp.data() + sent, resp.size() - sent, 0);
+                if (n <= 0) break;
+                sent += (size_t)n;
+            }
+            ::close(client);
+        }
+    });
+    return true;
+}
+
+void MetricsRegistry::stop() {
+    if (!serving_.exchange(false)) return;
+    ::shutdown(listen_fd_, SHUT_RDWR);   // unblocks accept()
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    if (server_.joinable()) server_.join();
+}
+#else
+bool MetricsRegistry::serve(int) { return false; }
+void MetricsRegistry::stop() {}
+#endif
@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Lock-free metric primitives. Registration takes a mutex once; every update
+// afterwards is a relaxed atomic op so loaders and queries can record freely.
+class Counter {
+public:
+    void inc(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+class Gauge {
+public:
+    void set(double v);
+    void add(double v);
+    double value() const;
+
+private:
+    std::atomic<uint64_t> bits_{0};   // double stored bitwise (no atomic<double>::fetch_add in C++17)
+};
+
+class Histogram {
+public:
+    explicit Histogram(std::vector<double> upperBounds);
+
+    void observe(double v);
+
+    const std::vector<double>& bounds() const { return bounds_; }
+    uint64_t bucketCount(size_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    double sum() const { return sum_.value(); }
+
+private:
+    std::vector<double> bounds_;                 // sorted, +Inf implied
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+    std::atomic<uint64_t> count_{0};
+    Gauge sum_;
+};
+
+// mini1_ingest_lag_seconds for one load: wall clock minus the newest
+// observation seen so far. Loader tasks report concurrently; the newest
+// timestamp is per instance, so separate loads never mix.
+class IngestLag {
+public:
+    explicit IngestLag(const std::string& labels);
+
+    void observe(int32_t newestUtcMinutes);
+
+private:
+    Gauge& gauge_;
+    std::atomic<int32_t> newest_{INT32_MIN};
+};
+
+// Process-wide registry with Prometheus text exposition (format 0.0.4).
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    // Same (name, labels) returns the same metric. labels is the raw label
+    // body, e.g. R"(op="findByRange")", or empty.
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::string& labels = "",
+                         std::vector<double> upperBounds = defaultLatencyBuckets());
+
+    static std::vector<double> defaultLatencyBuckets();   // seconds, 10us .. 10s
+
+    std::string exportText() const;
+    bool writeToFile(const std::string& path) const;
+
+    // Serve exportText() over HTTP on 127.0.0.1:port from a background thread.
+    bool serve(int port);
+    void stop();
+
+    ~MetricsRegistry();
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    enum class Kind { Counter, Gauge, Histogram };
+    struct Entry {
+        Kind kind;
+        std::string name;
+        std::string help;
+        std::string labels;
+        Counter* counter = nullptr;
+        Gauge* gauge = nullptr;
+        Histogram* histogram = nullptr;
+    };
+
+    Entry* find(Kind kind, const std::string& name, const std::string& labels);
+
+    mutable std::mutex mu_;            // guards registration and export only
+    std::vector<Entry> entries_;
+    std::deque<Counter> counters_;     // deque: stable addresses on growth
+    std::deque<Gauge> gauges_;
+    std::deque<Histogram> histograms_;
+
+    std::thread server_;
+    std::atomic<bool> serving_{false};
+    int listen_fd_ = -1;
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace radix_detail {
+
+// Unsigned image of a key with the same order: signed integers flip the
+// sign bit; floats flip every bit when negative, else the sign bit. -0.0
+// maps like +0.0 so the two stay in input order, as with operator<.
+template <typename K>
+inline auto bits(K k) {
+    if constexpr (std::is_floating_point<K>::value) {
+        using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+        if (k == 0) k = 0;
+        U u;
+        std::memcpy(&u, &k, sizeof u);
+        const U sign = U(1) << (8 * sizeof(U) - 1);
+        return (U)((u & sign) ? ~u : (u | sign));
+    } else if constexpr (std::is_signed<K>::value) {
+        using U = std::make_unsigned_t<K>;
+        return (U)((U)k ^ (U)(U(1) << (8 * sizeof(U) - 1)));
+    } else {
+        return k;
+    }
+}
+
+} // namespace radix_detail
+
+// Stable LSD radix sort of v by key(element), 8 bits per pass. Each thread
+// histograms its contiguous slice; an exclusive prefix over (digit, thread)
+// gives every thread its own output run per digit, so the scatter needs no
+// synchronisation. The scatter stages elements in per-digit write-combining
+// buffers of two cache lines and copies them out whole. A pass whose digit
+// is the same for every key is skipped. Keys: integers, float, double.
+template <typename T, typename KeyFn>
+void parallel_radix_sort(std::vector<T>& v, KeyFn key) {
+    using U = decltype(radix_detail::bits(key(std::declval<const T&>())));
+    constexpr int kPasses = (int)sizeof(U);
+    constexpr size_t kBuffered = std::max<size_t>(1, 128 / sizeof(T));
+
+    const size_t n = v.size();
+    if (n < 256) {
+        std::stable_sort(v.begin(), v.end(), [&](const T& a, const T& b) {
+            return radix_detail::bits(key(a)) < radix_detail::bits(key(b));
+        });
+        return;
+    }
+
+    std::vector<T> scratch(n);
+    T* src = v.data();
+    T* dst = scratch.data();
+    std::vector<size_t> offsets;   // [thread][digit]
+    bool skip = false;
+
+    #pragma omp parallel if (n >= (1u << 16))
+    {
+        size_t threads = 1, t = 0;
+#ifdef _OPENMP
+        threads = (size_t)omp_get_num_threads();
+        t = (size_t)omp_get_thread_num();
+#endif
+        const size_t begin = n * t / threads, end = n * (t + 1) / threads;
+        std::vector<T> staged(256 * kBuffered);
+        size_t fill[256];
+
+        #pragma omp single
+        offsets.assign(threads * 256, 0);
+
+        for (int pass = 0; pass < kPasses; ++pass) {
+            const int shift = 8 * pass;
+            auto digit = [&](const T& e) { return (size_t)((radix_detail::bits(key(e)) >> shift) & 0xff); };
+
+            size_t* mine = offsets.data() + t * 256;
+            std::fill(mine, mine + 256, 0);
+            for (size_t i = begin; i < end; ++i) ++mine[digit(src[i])];
+            #pragma omp barrier
+
+            #pragma omp single
+            {
+                skip = false;
+                size_t sum = 0;
+                for (size_t d = 0; d < 256; ++d) {
+                    const size_t first = sum;
+                    for (size_t th = 0; th < threads; ++th) {
+                        const size_t count = offsets[th * 256 + d];
+                        offsets[th * 256 + d] = sum;
+                        sum += count;
+                    }
+                    if (sum - first == n) skip = true;
+                }
+            }
+
+            if (!skip) {
+                std::fill(fill, fill + 256, 0);
+                for (size_t i = begin; i < end; ++i) {
+                    const size_t d = digit(src[i]);
+                    T* buffer = staged.data() + d * kBuffered;
+                    buffer[fill[d]++] = src[i];
+                    if (fill[d] == kBuffered) {
+                        std::copy(buffer, buffer + kBuffered, dst + mine[d]);
+                        mine[d] += kBuffered;
+                        fill[d] = 0;
+                    }
+                }
+                for (size_t d = 0; d < 256; ++d) {
+                    std::copy(staged.data() + d * kBuffered, staged.data() + d * kBuffered + fill[d], dst + mine[d]);
+                }
+            }
+            #pragma omp barrier
+
+            #pragma omp single
+            if (!skip) std::swap(src, dst);
+        }
+    }
+    if (src != v.data()) v.swap(scratch);
+}
+
+// Pairs by .first, e.g. (key, row) for index builds; ties keep input order.
+template <typename K, typename V>
+void parallel_radix_sort(std::vector<std::pair<K, V>>& v) {
+    parallel_radix_sort(v, [](const std::pair<K, V>& p) { return p.first; });
+}
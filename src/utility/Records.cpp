@@ -1,5 +1,10 @@
 #include "Records.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
 // Conversion functions for legacy compatibility
 RecordView record_to_view(const Record& record) {
     RecordView view;
@@ -34,43 +39,198 @@ RecordViews records_to_views(const Records& records) {
 
 // RecordView getter implementations
 std::string RecordView::getCountryName(const Dictionaries& dicts) const {
-    if (type == Type::WorldBank && country_name_id < dicts.country_names.size()) {
-        return dicts.country_names[country_name_id];
+    if (type == Type::WorldBank && country_name_id < dicts.frozen.country_name.size()) {
+        return std::string(dicts.frozen.country_name.name(country_name_id));
     }
     return "";
 }
 
 std::string RecordView::getParameterName(const Dictionaries& dicts) const {
-    if (type == Type::Fire && parameter_id < dicts.parameter_names.size()) {
-        return dicts.parameter_names[parameter_id];
+    if (type == Type::Fire && parameter_id < dicts.frozen.parameter.size()) {
+        return std::string(dicts.frozen.parameter.name(parameter_id));
     }
     return "";
 }
 
 std::string RecordView::getUnitName(const Dictionaries& dicts) const {
-    if (type == Type::Fire && unit_id < dicts.unit_names.size()) {
-        return dicts.unit_names[unit_id];
+    if (type == Type::Fire && unit_id < dicts.frozen.unit.size()) {
+        return std::string(dicts.frozen.unit.name(unit_id));
     }
     return "";
 }
 
 std::string RecordView::getSiteName(const Dictionaries& dicts) const {
-    if (type == Type::Fire && site_id < dicts.site_names.size()) {
-        return dicts.site_names[site_id];
+    if (type == Type::Fire && site_id < dicts.frozen.site.size()) {
+        return std::string(dicts.frozen.site.name(site_id));
     }
     return "";
 }
 
 std::string RecordView::getAgencyName(const Dictionaries& dicts) const {
-    if (type == Type::Fire && agency_id < dicts.agency_names.size()) {
-        return dicts.agency_names[agency_id];
+    if (type == Type::Fire && agency_id < dicts.frozen.agency.size()) {
+        return std::string(dicts.frozen.agency.name(agency_id));
     }
     return "";
 }
 
 std::string RecordView::getAqsName(const Dictionaries& dicts) const {
-    if (type == Type::Fire && aqs_id < dicts.aqs_names.size()) {
-        return dicts.aqs_names[aqs_id];
+    if (type == Type::Fire && aqs_id < dicts.frozen.aqs.size()) {
+        return std::string(dicts.frozen.aqs.name(aqs_id));
     }
     return "";
 }
+
+// -------- memory accounting --------
+template <typename Map>
+static size_t map_bytes(const Map& m) {
+    // node = key + value + next pointer + cached hash; plus the bucket array
+    size_t bytes = m.bucket_count() * sizeof(void*);
+    for (const auto& [key, id] : m) {
+        bytes += sizeof(typename Map::value_type) + 2 * sizeof(void*);
+        if (key.capacity() > 15) bytes += key.capacity() + 1;   // beyond SSO
+    }
+    return bytes;
+}
+
+static size_t names_bytes(const std::vector<std::string>& names) {
+    size_t bytes = names.capacity() * sizeof(std::string);
+    for (const auto& s : names) if (s.capacity() > 15) bytes += s.capacity() + 1;
+    return bytes;
+}
+
+size_t SiteRecordHash::operator()(const SiteRecord& s) const {
+    uint32_t lat, lon;
+    std::memcpy(&lat, &s.latitude, sizeof(lat));
+    std::memcpy(&lon, &s.longitude, sizeof(lon));
+    uint64_t h = ((uint64_t)lat << 32 | lon) * 0x9E3779B97F4A7C15ull;
+    h ^= ((uint64_t)s.name_id << 32 | s.agency_id) + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2);
+    h ^= (uint64_t)s.aqs_id + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    return (size_t)h;
+}
+
+size_t dictionaries_memory_bytes(const Dictionaries& d) {
+    const size_t siteBytes = d.sites.capacity() * sizeof(SiteRecord)
+        + d.site_rows.bucket_count() * sizeof(void*)
+        + d.site_rows.size() * (sizeof(std::pair<const SiteRecord, uint32_t>) + 2 * sizeof(void*));
+    const auto& f = d.frozen;
+    const size_t frozenBytes = f.parameter.memoryBytes() + f.unit.memoryBytes() + f.site.memoryBytes()
+        + f.agency.memoryBytes() + f.aqs.memoryBytes() + f.country_name.memoryBytes()
+        + f.country_code.memoryBytes() + f.indicator.memoryBytes();
+    return siteBytes + frozenBytes + map_bytes(d.parameter_dict) + map_bytes(d.unit_dict) + map_bytes(d.site_dict)
+         + map_bytes(d.agency_dict) + map_bytes(d.aqs_dict) + map_bytes(d.country_name_dict)
+         + map_bytes(d.country_code_dict) + map_bytes(d.indicator_dict)
+         + names_bytes(d.parameter_names) + names_bytes(d.unit_names) + names_bytes(d.site_names)
+         + names_bytes(d.agency_names) + names_bytes(d.aqs_names) + names_bytes(d.country_names)
+         + names_bytes(d.country_codes) + names_bytes(d.indicator_names);
+}
+
+// -------- dictionary merging --------
+template <typename Id>
+static std::vector<uint32_t> merge_into(std::unordered_map<std::string, Id>& global, std::vector<std::string>& globalNames,
+                                        const std::vector<std::string>& localNames) {
+    std::vector<uint32_t> remap(localNames.size());
+    for (size_t localId = 0; localId < localNames.size(); ++localId) {
+        remap[localId] = dict_get_or_add_named(global, globalNames, localNames[localId]);
+    }
+    return remap;
+}
+
+std::vector<DictionaryRemap> merge_dictionaries(Dictionaries& g, const std::vector<Dictionaries>& locals) {
+    std::vector<DictionaryRemap> remaps(locals.size());
+    for (size_t i = 0; i < locals.size(); ++i) {
+        const Dictionaries& d = locals[i];
+        DictionaryRemap& r = remaps[i];
+        r.parameter    = merge_into(g.parameter_dict, g.parameter_names, d.parameter_names);
+        r.unit         = merge_into(g.unit_dict, g.unit_names, d.unit_names);
+        r.site         = merge_into(g.site_dict, g.site_names, d.site_names);
+        r.agency       = merge_into(g.agency_dict, g.agency_names, d.agency_names);
+        r.aqs          = merge_into(g.aqs_dict, g.aqs_names, d.aqs_names);
+        r.country_name = merge_into(g.country_name_dict, g.country_names, d.country_names);
+        r.country_code = merge_into(g.country_code_dict, g.country_codes, d.country_codes);
+        r.indicator    = merge_into(g.indicator_dict, g.indicator_names, d.indicator_names);
+
+        // Site rows carry dictionary ids, so they merge after those are remapped
+        r.site_row.resize(d.sites.size());
+        for (size_t localId = 0; localId < d.sites.size(); ++localId) {
+            SiteRecord site = d.sites[localId];
+            site.name_id   = r.site[site.name_id];
+            site.agency_id = r.agency[site.agency_id];
+            site.aqs_id    = r.aqs[site.aqs_id];
+            r.site_row[localId] = site_get_or_add(g, site);
+        }
+    }
+    return remaps;
+}
+
+// -------- order-preserving finalize --------
+template <typename Id>
+static std::vector<uint32_t> sort_names(std::unordered_map<std::string, Id>& dict, std::vector<std::string>& names) {
+    std::vector<uint32_t> byName(names.size());   // new id -> old id
+    std::iota(byName.begin(), byName.end(), 0u);
+    std::sort(byName.begin(), byName.end(), [&](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+    std::vector<uint32_t> remap(names.size());    // old id -> new id
+    std::vector<std::string> sorted(names.size());
+    for (uint32_t id = 0; id < (uint32_t)byName.size(); ++id) {
+        remap[byName[id]] = id;
+        sorted[id] = std::move(names[byName[id]]);
+    }
+    names = std::move(sorted);
+    for (auto& entry : dict) entry.second = (Id)remap[entry.second];
+    return remap;
+}
+
+DictionaryRemap sort_dictionaries(Dictionaries& d) {
+    DictionaryRemap r;
+    r.parameter    = sort_names(d.parameter_dict, d.parameter_names);
+    r.unit         = sort_names(d.unit_dict, d.unit_names);
+    r.site         = sort_names(d.site_dict, d.site_names);
+    r.agency       = sort_names(d.agency_dict, d.agency_names);
+    r.aqs          = sort_names(d.aqs_dict, d.aqs_names);
+    r.country_name = sort_names(d.country_name_dict, d.country_names);
+    r.country_code = sort_names(d.country_code_dict, d.country_codes);
+    r.indicator    = sort_names(d.indicator_dict, d.indicator_names);
+
+    // Dimension rows keep their position; their keys change, so rehash
+    d.site_rows.clear();
+    r.site_row.resize(d.sites.size());
+    for (uint32_t i = 0; i < (uint32_t)d.sites.size(); ++i) {
+        SiteRecord& site = d.sites[i];
+        site.name_id   = r.site[site.name_id];
+        site.agency_id = r.agency[site.agency_id];
+        site.aqs_id    = r.aqs[site.aqs_id];
+        d.site_rows.emplace(site, i);
+        r.site_row[i] = i;
+    }
+    return r;
+}
+
+void freeze_dictionaries(Dictionaries& d) {
+    auto freeze = [](auto& dict, std::vector<std::string>& names, FrozenDictionary& out) {
+        out = FrozenDictionary(names);
+        std::remove_reference_t<decltype(dict)>().swap(dict);
+        std::vector<std::string>().swap(names);
+    };
+    freeze(d.parameter_dict, d.parameter_names, d.frozen.parameter);
+    freeze(d.unit_dict, d.unit_names, d.frozen.unit);
+    freeze(d.site_dict, d.site_names, d.frozen.site);
+    freeze(d.agency_dict, d.agency_names, d.frozen.agency);
+    freeze(d.aqs_dict, d.aqs_names, d.frozen.aqs);
+    freeze(d.country_name_dict, d.country_names, d.frozen.country_name);
+    freeze(d.country_code_dict, d.country_codes, d.frozen.country_code);
+    freeze(d.indicator_dict, d.indicator_names, d.frozen.indicator);
+    // Site rows are final; the dedup map is only needed while loading
+    decltype(d.site_rows)().swap(d.site_rows);
+    d.sites.shrink_to_fit();
+}
+
+void DictionaryRemap::apply(FireRecord& rec) const {
+    rec.parameter_id = (uint16_t)parameter[rec.parameter_id];
+    rec.unit_id      = (uint16_t)unit[rec.unit_id];
+    rec.site_id      = site_row[rec.site_id];
+}
+
+void DictionaryRemap::apply(WorldBankRecord& rec) const {
+    rec.country_name_id = country_name[rec.country_name_id];
+    rec.country_code_id = country_code[rec.country_code_id];
+    rec.indicator_id    = (uint16_t)indicator[rec.indicator_id];
+}
@@ -1,13 +1,39 @@
 #pragma once
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
+#include "utility/FrozenDictionary.h"
+
 // Lean, dataset-specific record structures
-struct FireRecord {
+
+// Site dimension row: the static attributes of one monitor. Fire rows refer
+// to it by site_id. Rows differ when any attribute differs, so a site name
+// reported at two locations gets two rows.
+struct SiteRecord {
     float latitude = 0.0f;
     float longitude = 0.0f;
+    uint32_t name_id = 0;           // Dictionary-encoded site name
+    uint32_t agency_id = 0;         // Dictionary-encoded
+    uint32_t aqs_id = 0;            // Dictionary-encoded
+
+    // Bitwise on coordinates, matching the hash (NaN equals itself)
+    bool operator==(const SiteRecord& o) const {
+        return std::memcmp(&latitude, &o.latitude, sizeof(float)) == 0
+            && std::memcmp(&longitude, &o.longitude, sizeof(float)) == 0
+            && name_id == o.name_id && agency_id == o.agency_id && aqs_id == o.aqs_id;
+    }
+};
+
+struct SiteRecordHash {
+    size_t operator()(const SiteRecord& s) const;
+};
+
+using SiteTable = std::vector<SiteRecord>;
+
+struct FireRecord {
     int32_t utc_minutes = 0;        // 32-bit is plenty for 1970-2100
     uint16_t parameter_id = 0;      // Dictionary-encoded
     uint16_t unit_id = 0;           // Dictionary-encoded
@@ -15,21 +41,19 @@ struct FireRecord {
     float raw_value = 0.0f;
     int16_t aqi = -999;
     uint8_t category = 0;
-    uint32_t site_id = 0;           // Dictionary-encoded
-    uint32_t agency_id = 0;         // Dictionary-encoded
-    uint32_t aqs_id = 0;            // Dictionary-encoded
+    uint32_t site_id = 0;           // Row in the site dimension (Dictionaries::sites)
     
     // Derived fields for unified API
     int year = 0;                   // Derived from utc_minutes
     double numericValue = 0.0;      // Maps to value
     
+    FireRecord() = default;   // allows pre-sized load buffers
+
     // Constructor for emplace_back optimization
-    FireRecord(float lat, float lon, int32_t utc, uint16_t param, uint16_t unit,
-               float val, float raw, int16_t a, uint8_t cat, uint32_t site, 
-               uint32_t agency, uint32_t aqs, int yr, double numeric)
-        : latitude(lat), longitude(lon), utc_minutes(utc), parameter_id(param), 
-          unit_id(unit), value(val), raw_value(raw), aqi(a), category(cat),
-          site_id(site), agency_id(agency), aqs_id(aqs), year(yr), numericValue(numeric) {}
+    FireRecord(int32_t utc, uint16_t param, uint16_t unit, float val, float raw, int16_t a, uint8_t cat,
+               uint32_t site, int yr, double numeric)
+        : utc_minutes(utc), parameter_id(param), unit_id(unit), value(val), raw_value(raw), aqi(a),
+          category(cat), site_id(site), year(yr), numericValue(numeric) {}
 };
 
 struct WorldBankRecord {
@@ -42,6 +66,8 @@ struct WorldBankRecord {
     // Derived field for unified API
     double numericValue = 0.0;      // Maps to population
     
+    WorldBankRecord() = default;   // allows pre-sized load buffers
+
     // Constructor for emplace_back optimization
     WorldBankRecord(uint32_t cn_id, uint32_t cc_id, uint16_t ind_id, int16_t yr, double pop, double numeric)
         : country_name_id(cn_id), country_code_id(cc_id), indicator_id(ind_id), 
@@ -50,7 +76,9 @@ struct WorldBankRecord {
 
 // Dictionary storage (separate from records)
 struct Dictionaries {
-    // Fire/air quality dictionaries
+    // Fire/air quality dictionaries. The vector loader's per-task encoding
+    // (BatchEncoder) fills only the name vectors and sites; these maps are
+    // kept by merges and the map source.
     std::unordered_map<std::string, uint32_t> parameter_dict;
     std::unordered_map<std::string, uint32_t> unit_dict;
     std::unordered_map<std::string, uint32_t> site_dict;
@@ -71,8 +99,75 @@ struct Dictionaries {
     std::vector<std::string> country_names;
     std::vector<std::string> country_codes;
     std::vector<std::string> indicator_names;
+
+    // Fire site dimension: FireRecord::site_id indexes sites
+    SiteTable sites;
+    std::unordered_map<SiteRecord, uint32_t, SiteRecordHash> site_rows;
+
+    // Read-only form after load (freeze_dictionaries); the maps, name
+    // vectors and site_rows above are empty from then on
+    struct Frozen {
+        FrozenDictionary parameter, unit, site, agency, aqs;
+        FrozenDictionary country_name, country_code, indicator;
+    } frozen;
+};
+
+// Approximate heap footprint of all dictionaries (keys, nodes, buckets, names).
+size_t dictionaries_memory_bytes(const Dictionaries& dicts);
+
+// Get-or-add that also records first-seen names, for per-task load dictionaries.
+template <typename Id>
+inline Id dict_get_or_add_named(std::unordered_map<std::string, Id>& dict, std::vector<std::string>& names,
+                                const std::string& key) {
+    auto it = dict.find(key);
+    if (it != dict.end()) return it->second;
+    Id id = (Id)dict.size();
+    dict.emplace(key, id);
+    names.push_back(key);
+    return id;
+}
+
+// Get-or-add a site dimension row; ids follow first-seen order.
+inline uint32_t site_get_or_add(Dictionaries& dicts, const SiteRecord& site) {
+    auto it = dicts.site_rows.find(site);
+    if (it != dicts.site_rows.end()) return it->second;
+    uint32_t id = (uint32_t)dicts.sites.size();
+    dicts.site_rows.emplace(site, id);
+    dicts.sites.push_back(site);
+    return id;
+}
+
+// Site-set filter: flags[site_id] for the dimension rows passing pred, so a
+// predicate on a site attribute is tested once per site, not once per row.
+template <typename Pred>
+inline std::vector<uint8_t> select_sites(const SiteTable& sites, Pred pred) {
+    std::vector<uint8_t> flags(sites.size());
+    for (size_t i = 0; i < sites.size(); ++i) flags[i] = pred(sites[i]) ? 1 : 0;
+    return flags;
+}
+
+// Local id -> global id for every dictionary of one load task.
+struct DictionaryRemap {
+    std::vector<uint32_t> parameter, unit, site, agency, aqs, site_row;
+    std::vector<uint32_t> country_name, country_code, indicator;
+
+    void apply(FireRecord& rec) const;
+    void apply(WorldBankRecord& rec) const;
 };
 
+// Merge task-local dictionaries into global in task order, following each
+// task's first-seen order, so ids match a serial load of the same tasks.
+std::vector<DictionaryRemap> merge_dictionaries(Dictionaries& global, const std::vector<Dictionaries>& locals);
+
+// Post-load finalize: reassign every dictionary's ids in byte order of the
+// names, so an id range is a name range. Site dimension rows are updated in
+// place (their site_id stays); the returned remap is for the fact rows.
+DictionaryRemap sort_dictionaries(Dictionaries& dicts);
+
+// Post-sort: move every dictionary into its FrozenDictionary and release the
+// load-time maps and name vectors. Nothing can be added afterwards.
+void freeze_dictionaries(Dictionaries& dicts);
+
 // Read-only view for unified API results
 struct RecordView {
     enum class Type { Fire, WorldBank };